@@ -0,0 +1,205 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "assignment_solver.hpp"
+#include "hungarian_algorithm.hpp"
+#include "incremental_assignment.hpp"
+#include "matrix.hpp"
+
+// Run time of the O(n^3) Jonker-Volgenant solver vs. the classic Munkres star/prime loop on
+// random square cost matrices of n = 100 ... 5000. Munkres is only run up to a size limit
+// (default 1000, it grows roughly as n^4); wherever both run, their total costs must agree.
+// A second table solves rectangular n x m problems (few rows, many columns) natively and, where
+// it fits, compares against the same problem padded to m x m with zero-cost dummy rows.
+// A third table replays scheduler-like ticks (a few cost changes, sometimes a row swapped out)
+// on IncrementalAssignment and compares against solving every tick from scratch.
+// usage: a4_assignment_benchmark [max n for Munkres] [max cost]
+
+namespace {
+
+Matrix<int> random_cost_matrix(std::size_t size, int maxCost, std::mt19937& generator) {
+    std::uniform_int_distribution<int> costDistribution(0, maxCost);
+    Matrix<int> costMatrix(size, size, uninitialized);
+    for (std::size_t row = 0; row < size; row++) {
+        for (std::size_t col = 0; col < size; col++) {
+            costMatrix(row, col) = costDistribution(generator);
+        }
+    }
+    return costMatrix;
+}
+
+std::vector<int> random_costs(std::size_t count, int maxCost, std::mt19937& generator) {
+    std::uniform_int_distribution<int> costDistribution(0, maxCost);
+    std::vector<int> costs(count);
+    for (int& cost : costs) {
+        cost = costDistribution(generator);
+    }
+    return costs;
+}
+
+// Sum of the costs selected by an assignment matrix
+int64_t assignment_cost(const Matrix<int>& costMatrix, const Matrix<int>& assignment) {
+    int64_t totalCost = 0;
+    for (std::size_t row = 0; row < costMatrix.nrows(); row++) {
+        for (std::size_t col = 0; col < costMatrix.ncols(); col++) {
+            if (assignment(row, col) == 1) {
+                totalCost += costMatrix(row, col);
+            }
+        }
+    }
+    return totalCost;
+}
+
+// Runs solver(costMatrix), storing the elapsed seconds in `seconds`
+template <typename Solver>
+Matrix<int> timed(Solver solver, const Matrix<int>& costMatrix, double& seconds) {
+    auto start = std::chrono::steady_clock::now();
+    Matrix<int> assignment = solver(costMatrix);
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return assignment;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[]) {
+    std::size_t munkresLimit = argc > 1 ? std::stoul(argv[1]) : 1000;
+    int maxCost = argc > 2 ? std::stoi(argv[2]) : 1000;
+
+    const std::size_t sizes[] = {100, 200, 500, 1000, 2000, 5000};
+    std::mt19937 generator(2024);
+
+    std::cout << std::setw(6) << "n" << std::setw(16) << "cost"
+        << std::setw(14) << "jv [s]" << std::setw(14) << "munkres [s]" << std::setw(10) << "speedup" << '\n';
+
+    for (std::size_t size : sizes) {
+        Matrix<int> costMatrix = random_cost_matrix(size, maxCost, generator);
+
+        double jvSeconds = 0.0;
+        Matrix<int> jvAssignment = timed(run_jonker_volgenant_algorithm, costMatrix, jvSeconds);
+        int64_t jvCost = assignment_cost(costMatrix, jvAssignment);
+
+        std::cout << std::setw(6) << size << std::setw(16) << jvCost
+            << std::fixed << std::setprecision(4) << std::setw(14) << jvSeconds;
+
+        if (size <= munkresLimit) {
+            double munkresSeconds = 0.0;
+            Matrix<int> munkresAssignment = timed(run_munkres_algorithm, costMatrix, munkresSeconds);
+            if (assignment_cost(costMatrix, munkresAssignment) != jvCost) {
+                std::cout << std::endl;
+                std::cerr << "Solvers disagree on the optimal cost for n = " << size << std::endl;
+                return 1;
+            }
+            std::cout << std::setw(14) << munkresSeconds
+                << std::setprecision(1) << std::setw(9) << munkresSeconds / jvSeconds << 'x';
+        }
+        else {
+            std::cout << std::setw(14) << "-" << std::setw(10) << "-";
+        }
+        std::cout << std::endl;
+    }
+
+    // Rectangular: native vs. padded to square (only while the square stays at most 5000 x 5000)
+    const std::size_t shapes[][2] = {{100, 2000}, {200, 5000}, {500, 20000}, {300, 50000}};
+    const std::size_t paddingLimit = 5000;
+
+    std::cout << '\n' << std::setw(6) << "n" << std::setw(8) << "m" << std::setw(12) << "cost"
+        << std::setw(14) << "native [s]" << std::setw(14) << "padded [s]" << '\n';
+
+    for (const auto& shape : shapes) {
+        std::size_t rowCount = shape[0];
+        std::size_t columnCount = shape[1];
+        std::vector<int> costs = random_costs(rowCount * columnCount, maxCost, generator);
+
+        auto start = std::chrono::steady_clock::now();
+        AssignmentResult<int> native = solve_assignment(std::span<const int>(costs), rowCount, columnCount);
+        double nativeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << std::setw(6) << rowCount << std::setw(8) << columnCount << std::setw(12) << native.totalCost
+            << std::fixed << std::setprecision(4) << std::setw(14) << nativeSeconds;
+
+        if (columnCount <= paddingLimit) {
+            // Dummy rows cost nothing, so the optimum of the padded problem is the same
+            std::vector<int> padded(columnCount * columnCount, 0);
+            std::copy(costs.begin(), costs.end(), padded.begin());
+
+            start = std::chrono::steady_clock::now();
+            AssignmentResult<int> square = solve_assignment(std::span<const int>(padded), columnCount, columnCount);
+            double paddedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if (square.totalCost != native.totalCost) {
+                std::cout << std::endl;
+                std::cerr << "Padded and native solutions disagree for " << rowCount << " x " << columnCount
+                    << std::endl;
+                return 1;
+            }
+            std::cout << std::setw(14) << paddedSeconds;
+        }
+        else {
+            std::cout << std::setw(14) << "-";
+        }
+        std::cout << std::endl;
+    }
+
+    // Incremental: 100 ticks of 5 cost updates, every 10th tick also replaces a row
+    const std::size_t incrementalSizes[] = {500, 1000, 2000};
+    const int tickCount = 100;
+    const int updatesPerTick = 5;
+
+    std::cout << '\n' << std::setw(6) << "n" << std::setw(8) << "ticks" << std::setw(16) << "incremental [s]"
+        << std::setw(14) << "re-solve [s]" << std::setw(10) << "speedup" << '\n';
+
+    for (std::size_t size : incrementalSizes) {
+        Matrix<int> costMatrix = random_cost_matrix(size, maxCost, generator);
+        IncrementalAssignment<int> incremental(costMatrix);
+        std::uniform_int_distribution<std::size_t> indexDistribution(0, size - 1);
+        std::uniform_int_distribution<int> costDistribution(0, maxCost);
+
+        double incrementalSeconds = 0.0;
+        double resolveSeconds = 0.0;
+        for (int tick = 0; tick < tickCount; tick++) {
+            auto start = std::chrono::steady_clock::now();
+            for (int update = 0; update < updatesPerTick; update++) {
+                std::size_t row = indexDistribution(generator);
+                std::size_t col = indexDistribution(generator);
+                costMatrix(row, col) = costDistribution(generator);
+                incremental.update_cost(row, col, costMatrix(row, col));
+            }
+            if (tick % 10 == 9) {
+                // The oldest row leaves, a new one arrives as the last row
+                for (std::size_t row = 0; row + 1 < size; row++) {
+                    for (std::size_t col = 0; col < size; col++) {
+                        costMatrix(row, col) = costMatrix(row + 1, col);
+                    }
+                }
+                std::vector<int> newRow = random_costs(size, maxCost, generator);
+                for (std::size_t col = 0; col < size; col++) {
+                    costMatrix(size - 1, col) = newRow[col];
+                }
+                incremental.remove_row(0);
+                incremental.add_row(newRow);
+            }
+            incrementalSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            double tickSeconds = 0.0;
+            Matrix<int> fresh = timed(run_jonker_volgenant_algorithm, costMatrix, tickSeconds);
+            resolveSeconds += tickSeconds;
+            if (assignment_cost(costMatrix, fresh) != incremental.total_cost()) {
+                std::cerr << "Incremental solution is not optimal after tick " << tick << " for n = " << size
+                    << std::endl;
+                return 1;
+            }
+        }
+
+        std::cout << std::setw(6) << size << std::setw(8) << tickCount << std::fixed << std::setprecision(4)
+            << std::setw(16) << incrementalSeconds << std::setw(14) << resolveSeconds
+            << std::setprecision(1) << std::setw(9) << resolveSeconds / incrementalSeconds << 'x' << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,290 @@
+#ifndef ASSIGNMENT_SOLVER_HPP
+#define ASSIGNMENT_SOLVER_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "matrix.hpp"
+
+// Linear assignment (minimum-cost matching) on an n x m cost matrix
+// Every row of the smaller side is assigned to a distinct column of the larger side; no padding to
+// a square matrix is needed. Jonker-Volgenant style: dual potentials plus one shortest augmenting
+// path per free row, O(min(n,m)^2 * max(n,m)).
+// Besides the costs, which are only read, the solver keeps a handful of O(n + m) arrays: at
+// n = 10000 the only n x n storage is the caller's cost matrix.
+
+// Cost types accepted by solve_assignment
+template <typename Cost>
+concept AssignmentCost =
+    std::same_as<Cost, int32_t> || std::same_as<Cost, int64_t> ||
+    std::same_as<Cost, float> || std::same_as<Cost, double>;
+
+// Type of the dual potentials and of the total cost: int64_t for integer costs, double otherwise
+template <AssignmentCost Cost>
+using AssignmentSum = std::conditional_t<std::is_integral_v<Cost>, int64_t, double>;
+
+// Result of solve_assignment (and of the solvers in auction_assignment.hpp)
+template <AssignmentCost Cost>
+struct AssignmentResult {
+    std::vector<int> rowToColumn;       // Column assigned to each row, -1 if left unassigned (rows > columns)
+    AssignmentSum<Cost> totalCost = 0;  // Sum of the assigned costs
+    bool feasible = true;               // false if the allowed pairs admit no complete assignment
+};
+
+namespace assignment_detail {
+
+inline constexpr std::size_t unassigned = std::numeric_limits<std::size_t>::max();
+
+// Dual solution and matching of a rowCount x columnCount problem (rowCount <= columnCount)
+// The reduced cost c(i, j) - rowPotential[i] - columnPotential[j] is never negative, and it is
+// zero on every assigned pair. Column potentials only ever decrease, and only on assigned
+// columns, so a column left unassigned keeps potential zero (which is what makes the matching
+// optimal when there are more columns than rows)
+template <typename Sum>
+struct AssignmentDuals {
+    std::vector<Sum> rowPotential;
+    std::vector<Sum> columnPotential;
+    std::vector<std::size_t> rowOfColumn;  // `unassigned` if free
+    std::vector<std::size_t> columnOfRow;  // `unassigned` if free
+
+    AssignmentDuals(std::size_t rowCount, std::size_t columnCount)
+        : rowPotential(rowCount, 0), columnPotential(columnCount, 0),
+        rowOfColumn(columnCount, unassigned), columnOfRow(rowCount, unassigned) {
+    }
+};
+
+// Every pair is allowed
+struct AllPairsAllowed {
+    bool operator()(std::size_t, std::size_t) const { return true; }
+};
+
+// Row reduction: each row's potential is its minimum, and the row takes that minimum's column
+// if the column is still free (among equal minima a free one is preferred). Every such pair
+// has reduced cost zero
+template <typename Sum, typename CostAt>
+void row_reduction(AssignmentDuals<Sum>& duals, CostAt costAt) {
+    const std::size_t rowCount = duals.columnOfRow.size();
+    const std::size_t columnCount = duals.rowOfColumn.size();
+
+    for (std::size_t currentRow = 0; currentRow < rowCount; currentRow++) {
+        std::size_t minimumColumn = 0;
+        for (std::size_t currentColumn = 1; currentColumn < columnCount; currentColumn++) {
+            if (costAt(currentRow, currentColumn) < costAt(currentRow, minimumColumn) ||
+                (costAt(currentRow, currentColumn) == costAt(currentRow, minimumColumn) &&
+                    duals.rowOfColumn[minimumColumn] != unassigned)) {
+                minimumColumn = currentColumn;
+            }
+        }
+        duals.rowPotential[currentRow] = static_cast<Sum>(costAt(currentRow, minimumColumn));
+        if (duals.rowOfColumn[minimumColumn] == unassigned) {
+            duals.columnOfRow[currentRow] = minimumColumn;
+            duals.rowOfColumn[minimumColumn] = currentRow;
+        }
+    }
+}
+
+// AugmentingPathSearch class template
+// Scratch space of the shortest augmenting path search, reused between rows
+template <typename Sum>
+class AugmentingPathSearch {
+public:
+    explicit AugmentingPathSearch(std::size_t columnCount)
+        : shortestPathCost_(columnCount), predecessorColumn_(columnCount), isColumnScanned_(columnCount) {
+        scannedColumns_.reserve(columnCount);
+    }
+
+    // Assigns the free row `freeRow` along a shortest augmenting path over the reduced costs of
+    // the allowed pairs, then updates the potentials so the duals stay feasible
+    // Returns false, leaving the duals untouched, if no free column is reachable (only possible
+    // when isAllowed rules pairs out)
+    template <typename CostAt, typename IsAllowed>
+    bool augment(AssignmentDuals<Sum>& duals, std::size_t freeRow, CostAt costAt, IsAllowed isAllowed) {
+        const std::size_t columnCount = duals.rowOfColumn.size();
+        const Sum infinity = std::numeric_limits<Sum>::has_infinity ?
+            std::numeric_limits<Sum>::infinity() : std::numeric_limits<Sum>::max();
+
+        std::fill(shortestPathCost_.begin(), shortestPathCost_.end(), infinity);
+        std::fill(isColumnScanned_.begin(), isColumnScanned_.end(), false);
+        scannedColumns_.clear();
+
+        // Dijkstra over reduced costs: grow the tree of scanned columns from freeRow until it
+        // reaches a free column. pathLength is the distance of the last column scanned
+        std::size_t currentRow = freeRow;
+        std::size_t currentPredecessor = unassigned;
+        Sum pathLength = 0;
+        std::size_t freeColumn = unassigned;
+
+        // Raw pointers for the inner loop: the compiler cannot otherwise prove that the stores to
+        // the distances leave the other vectors alone, and reloads them every iteration
+        Sum* shortestPathCost = shortestPathCost_.data();
+        std::size_t* predecessorColumn = predecessorColumn_.data();
+        const Sum* columnPotential = duals.columnPotential.data();
+        const std::size_t* rowOfColumn = duals.rowOfColumn.data();
+
+        while (freeColumn == unassigned) {
+            Sum rowOffset = pathLength - duals.rowPotential[currentRow];
+            Sum smallestCost = infinity;
+            std::size_t nextColumn = unassigned;
+
+            for (std::size_t currentColumn = 0; currentColumn < columnCount; currentColumn++) {
+                if (isColumnScanned_[currentColumn]) {
+                    continue;
+                }
+                if (isAllowed(currentRow, currentColumn)) {
+                    Sum candidateCost = rowOffset + static_cast<Sum>(costAt(currentRow, currentColumn)) -
+                        columnPotential[currentColumn];
+                    if (candidateCost < shortestPathCost[currentColumn]) {
+                        shortestPathCost[currentColumn] = candidateCost;
+                        predecessorColumn[currentColumn] = currentPredecessor;
+                    }
+                }
+                // On ties prefer a free column: the path can end right there
+                if (shortestPathCost[currentColumn] < smallestCost ||
+                    (shortestPathCost[currentColumn] == smallestCost && rowOfColumn[currentColumn] == unassigned &&
+                        smallestCost != infinity)) {
+                    smallestCost = shortestPathCost[currentColumn];
+                    nextColumn = currentColumn;
+                }
+            }
+
+            if (nextColumn == unassigned) {
+                return false; // every reachable column is taken
+            }
+
+            isColumnScanned_[nextColumn] = true;
+            scannedColumns_.push_back(nextColumn);
+            pathLength = smallestCost;
+
+            if (duals.rowOfColumn[nextColumn] == unassigned) {
+                freeColumn = nextColumn;
+            }
+            else {
+                // Continue from the row that currently holds this column
+                currentRow = duals.rowOfColumn[nextColumn];
+                currentPredecessor = nextColumn;
+            }
+        }
+
+        // Update the potentials so that every edge of the tree has reduced cost zero
+        duals.rowPotential[freeRow] += pathLength;
+        for (std::size_t scannedColumn : scannedColumns_) {
+            if (scannedColumn == freeColumn) {
+                continue;
+            }
+            Sum slack = pathLength - shortestPathCost_[scannedColumn];
+            duals.columnPotential[scannedColumn] -= slack;
+            duals.rowPotential[duals.rowOfColumn[scannedColumn]] += slack;
+        }
+
+        // Flip the matching along the path, from the free column back to freeRow
+        std::size_t pathColumn = freeColumn;
+        while (pathColumn != unassigned) {
+            std::size_t previousColumn = predecessorColumn_[pathColumn];
+            std::size_t pathRow = previousColumn == unassigned ? freeRow : duals.rowOfColumn[previousColumn];
+            duals.rowOfColumn[pathColumn] = pathRow;
+            duals.columnOfRow[pathRow] = pathColumn;
+            pathColumn = previousColumn;
+        }
+        return true;
+    }
+
+private:
+    std::vector<Sum> shortestPathCost_;          // Dijkstra distance to each column
+    std::vector<std::size_t> predecessorColumn_; // previous column on the path, unassigned = start row
+    std::vector<bool> isColumnScanned_;
+    std::vector<std::size_t> scannedColumns_;
+};
+
+// Pads an optimal rowCount x columnCount solution to columnCount x columnCount with zero-cost
+// "spare" rows (slots rowCount, rowCount + 1, ...) that take the columns left over, in column
+// order. Those columns have potential zero, so a spare row with potential zero is tight there and
+// feasible everywhere. In the square problem a column can be freed or taken without breaking the
+// optimality conditions of the rectangular one
+template <typename Sum>
+void add_spare_rows(AssignmentDuals<Sum>& duals) {
+    const std::size_t columnCount = duals.rowOfColumn.size();
+    std::size_t slot = duals.columnOfRow.size();
+    duals.rowPotential.resize(columnCount, 0);
+    duals.columnOfRow.resize(columnCount, unassigned);
+    for (std::size_t column = 0; column < columnCount; column++) {
+        if (duals.rowOfColumn[column] == unassigned) {
+            duals.rowOfColumn[column] = slot;
+            duals.columnOfRow[slot] = column;
+            slot++;
+        }
+    }
+}
+
+// Shortest augmenting path solver for rowCount <= columnCount; costAt(row, column) returns a cost
+// Returns the optimal duals and matching
+template <typename Sum, typename CostAt>
+AssignmentDuals<Sum> shortest_augmenting_paths(std::size_t rowCount, std::size_t columnCount, CostAt costAt) {
+    AssignmentDuals<Sum> duals(rowCount, columnCount);
+    row_reduction(duals, costAt);
+
+    // Assign the remaining free rows one by one along a shortest augmenting path
+    AugmentingPathSearch<Sum> search(columnCount);
+    for (std::size_t freeRow = 0; freeRow < rowCount; freeRow++) {
+        if (duals.columnOfRow[freeRow] == unassigned) {
+            search.augment(duals, freeRow, costAt, AllPairsAllowed{});
+        }
+    }
+    return duals;
+}
+
+// Solves a rowCount x columnCount problem and packs the matching and its total cost into an
+// AssignmentResult. With more rows than columns the solver runs on the transpose, read in place
+template <AssignmentCost Cost, typename CostAt>
+AssignmentResult<Cost> solve(std::size_t rowCount, std::size_t columnCount, CostAt costAt) {
+    AssignmentResult<Cost> result;
+
+    if (rowCount <= columnCount) {
+        std::vector<std::size_t> columnOfRow =
+            shortest_augmenting_paths<AssignmentSum<Cost>>(rowCount, columnCount, costAt).columnOfRow;
+
+        result.rowToColumn.reserve(rowCount);
+        for (std::size_t row = 0; row < rowCount; row++) {
+            result.rowToColumn.push_back(static_cast<int>(columnOfRow[row]));
+            result.totalCost += static_cast<AssignmentSum<Cost>>(costAt(row, columnOfRow[row]));
+        }
+        return result;
+    }
+
+    std::vector<std::size_t> rowOfColumn = shortest_augmenting_paths<AssignmentSum<Cost>>(columnCount, rowCount,
+        [&](std::size_t column, std::size_t row) { return costAt(row, column); }).columnOfRow;
+
+    result.rowToColumn.assign(rowCount, -1);
+    for (std::size_t column = 0; column < columnCount; column++) {
+        result.rowToColumn[rowOfColumn[column]] = static_cast<int>(column);
+        result.totalCost += static_cast<AssignmentSum<Cost>>(costAt(rowOfColumn[column], column));
+    }
+    return result;
+}
+
+} // namespace assignment_detail
+
+// Solves the assignment problem for an n x m cost matrix (costs must be finite)
+// min(n, m) pairs are assigned; rows left over when n > m get column -1
+template <AssignmentCost Cost>
+AssignmentResult<Cost> solve_assignment(const Matrix<Cost>& costMatrix) {
+    return assignment_detail::solve<Cost>(costMatrix.nrows(), costMatrix.ncols(),
+        [&](std::size_t row, std::size_t column) { return costMatrix(row, column); });
+}
+
+// Same for costs stored row-major in a span of rowCount * columnCount values
+// Throws Matrix<Cost>::Invalid if the shape is empty or does not match the span
+template <AssignmentCost Cost>
+AssignmentResult<Cost> solve_assignment(std::span<const Cost> costs, std::size_t rowCount, std::size_t columnCount) {
+    if (rowCount == 0 || columnCount == 0 || costs.size() != rowCount * columnCount) {
+        throw typename Matrix<Cost>::Invalid{};
+    }
+    return assignment_detail::solve<Cost>(rowCount, columnCount,
+        [&](std::size_t row, std::size_t column) { return costs[row * columnCount + column]; });
+}
+
+#endif  // ASSIGNMENT_SOLVER_HPP
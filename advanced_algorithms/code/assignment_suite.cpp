@@ -0,0 +1,532 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "assignment_solver.hpp"
+#include "auction_assignment.hpp"
+#include "hungarian_algorithm.hpp"
+#include "incremental_assignment.hpp"
+#include "kbest_assignment.hpp"
+#include "matrix.hpp"
+
+// Correctness and performance gate for the assignment solvers
+// 1. Cross-check against brute force over every assignment, for every generator:
+//    - n = 1 .. 8: all solvers must reach the optimal cost, and the k = 10 best assignments of
+//      Murty's method must have the 10 lowest costs in order
+//    - rectangular n x m (n, m <= 6): solve_assignment for both shapes, IncrementalAssignment
+//      and Murty's k best for n < m
+//    - IncrementalAssignment after a random sequence of update_cost / add_row / remove_row calls
+//      must match a fresh solve after every step
+// 2. Timing: for larger n, every solver runs within its size limit and reports run time and
+//    peak RSS; all of them must agree with the Jonker-Volgenant cost.
+// Generators (all seeded): uniform, low rank, many ties, structured (|i - j| bands), sparse
+// (2% allowed pairs), plus adversarial cases for the Munkres zero search: Machol-Wien
+// (c(i, j) = i * j) and a constant matrix where every entry is a zero after reduction.
+// Exits with status 1 on the first disagreement.
+// usage: a4_assignment_suite [--seed S] [--max-n N] [--munkres-max-n N]
+
+namespace {
+
+struct Options {
+    unsigned int seed = 2024;
+    std::size_t maxSize = 1000;
+    std::size_t munkresMaxSize = 300;
+};
+
+struct Instance {
+    Matrix<int> costs;
+    std::vector<AssignmentEdge<int>> edges; // allowed pairs; all of them unless the generator is sparse
+};
+
+// Larger than any assignment that avoids it, at the sizes the suite runs
+constexpr int prohibitiveCost = 1'000'000'000;
+constexpr double sparseDensity = 0.02;
+
+using Generator = std::function<Instance(std::size_t, std::mt19937&)>;
+
+// Lists every entry as an allowed pair
+Instance dense_instance(Matrix<int> costs) {
+    Instance instance{std::move(costs), {}};
+    for (std::size_t row = 0; row < instance.costs.nrows(); row++) {
+        for (std::size_t col = 0; col < instance.costs.ncols(); col++) {
+            instance.edges.push_back({row, col, instance.costs(row, col)});
+        }
+    }
+    return instance;
+}
+
+Instance uniform_costs(std::size_t size, std::mt19937& generator) {
+    std::uniform_int_distribution<int> costDistribution(0, 100000);
+    Matrix<int> costs(size, size, uninitialized);
+    for (std::size_t row = 0; row < size; row++) {
+        for (std::size_t col = 0; col < size; col++) {
+            costs(row, col) = costDistribution(generator);
+        }
+    }
+    return dense_instance(std::move(costs));
+}
+
+// c(i, j) = sum over t < 3 of a(i, t) * b(t, j): many rows and columns look alike
+Instance low_rank_costs(std::size_t size, std::mt19937& generator) {
+    const std::size_t rank = 3;
+    std::uniform_int_distribution<int> factorDistribution(0, 100);
+    std::vector<int> rowFactors(size * rank);
+    std::vector<int> columnFactors(size * rank);
+    for (int& factor : rowFactors) factor = factorDistribution(generator);
+    for (int& factor : columnFactors) factor = factorDistribution(generator);
+
+    Matrix<int> costs(size, size, uninitialized);
+    for (std::size_t row = 0; row < size; row++) {
+        for (std::size_t col = 0; col < size; col++) {
+            int cost = 0;
+            for (std::size_t t = 0; t < rank; t++) {
+                cost += rowFactors[row * rank + t] * columnFactors[col * rank + t];
+            }
+            costs(row, col) = cost;
+        }
+    }
+    return dense_instance(std::move(costs));
+}
+
+// Costs 0 .. 3 only: huge numbers of optimal assignments and tied paths
+Instance many_ties_costs(std::size_t size, std::mt19937& generator) {
+    std::uniform_int_distribution<int> costDistribution(0, 3);
+    Matrix<int> costs(size, size, uninitialized);
+    for (std::size_t row = 0; row < size; row++) {
+        for (std::size_t col = 0; col < size; col++) {
+            costs(row, col) = costDistribution(generator);
+        }
+    }
+    return dense_instance(std::move(costs));
+}
+
+// Cost grows with the distance from a shifted diagonal, plus a little noise
+Instance structured_costs(std::size_t size, std::mt19937& generator) {
+    std::uniform_int_distribution<int> noiseDistribution(0, 9);
+    std::size_t shift = size / 3;
+    Matrix<int> costs(size, size, uninitialized);
+    for (std::size_t row = 0; row < size; row++) {
+        for (std::size_t col = 0; col < size; col++) {
+            std::size_t target = (row + shift) % size;
+            std::size_t distance = col > target ? col - target : target - col;
+            costs(row, col) = static_cast<int>(distance) * 10 + noiseDistribution(generator);
+        }
+    }
+    return dense_instance(std::move(costs));
+}
+
+// 2% allowed pairs plus one per row from a random permutation (so a complete assignment exists);
+// the dense form prices every other pair out
+Instance sparse_costs(std::size_t size, std::mt19937& generator) {
+    std::uniform_int_distribution<int> costDistribution(0, 100000);
+    std::bernoulli_distribution isAllowed(sparseDensity);
+    std::vector<std::size_t> permutation(size);
+    std::iota(permutation.begin(), permutation.end(), std::size_t{0});
+    std::shuffle(permutation.begin(), permutation.end(), generator);
+
+    Instance instance{Matrix<int>(size, size, prohibitiveCost), {}};
+    for (std::size_t row = 0; row < size; row++) {
+        for (std::size_t col = 0; col < size; col++) {
+            if (permutation[row] == col || isAllowed(generator)) {
+                int cost = costDistribution(generator);
+                instance.costs(row, col) = cost;
+                instance.edges.push_back({row, col, cost});
+            }
+        }
+    }
+    return instance;
+}
+
+// Machol-Wien: c(i, j) = i * j; the Munkres loop needs many cover adjustments
+Instance machol_wien_costs(std::size_t size, std::mt19937& /*generator*/) {
+    Matrix<int> costs(size, size, uninitialized);
+    for (std::size_t row = 0; row < size; row++) {
+        for (std::size_t col = 0; col < size; col++) {
+            costs(row, col) = static_cast<int>((row + 1) * (col + 1));
+        }
+    }
+    return dense_instance(std::move(costs));
+}
+
+// Every entry equal: after the reductions every cell is a zero for the Munkres search to visit
+Instance constant_costs(std::size_t size, std::mt19937& /*generator*/) {
+    return dense_instance(Matrix<int>(size, size, 7));
+}
+
+struct NamedGenerator {
+    const char* name;
+    Generator generate;
+};
+
+// A solver returns the optimal total cost, or -1 if it found the instance infeasible
+struct Solver {
+    const char* name;
+    std::size_t maxSize; // larger instances are skipped
+    std::function<int64_t(const Instance&)> solve;
+};
+
+int64_t cost_of(const Matrix<int>& costs, const Matrix<int>& assignment) {
+    int64_t totalCost = 0;
+    for (std::size_t row = 0; row < costs.nrows(); row++) {
+        for (std::size_t col = 0; col < costs.ncols(); col++) {
+            if (assignment(row, col) == 1) {
+                totalCost += costs(row, col);
+            }
+        }
+    }
+    return totalCost;
+}
+
+std::vector<Solver> make_solvers(const Options& options) {
+    return {
+        {"munkres", options.munkresMaxSize, [](const Instance& instance) {
+            return cost_of(instance.costs, run_munkres_algorithm(instance.costs));
+        }},
+        {"jonker-volgenant", SIZE_MAX, [](const Instance& instance) {
+            return solve_assignment(instance.costs).totalCost;
+        }},
+        {"incremental", SIZE_MAX, [](const Instance& instance) {
+            return IncrementalAssignment<int>(instance.costs).total_cost();
+        }},
+        {"murty k=1", SIZE_MAX, [](const Instance& instance) {
+            return k_best_assignments(instance.costs, 1).front().totalCost;
+        }},
+        {"auction (parallel)", SIZE_MAX, [](const Instance& instance) {
+            return solve_parallel_auction(instance.costs).totalCost;
+        }},
+        {"auction (sparse)", SIZE_MAX, [](const Instance& instance) {
+            SparseCostMatrix<int> sparse(instance.costs.nrows(), instance.costs.ncols(), instance.edges);
+            AssignmentResult<int> result = solve_sparse_assignment(sparse);
+            return result.feasible ? result.totalCost : int64_t{-1};
+        }},
+    };
+}
+
+// Adds the cost of every way to give each of the remaining rows its own unused column
+void enumerate_assignments(const Matrix<int>& costs, bool transposed, std::size_t row, int64_t partialCost,
+    std::vector<bool>& isColumnUsed, std::vector<int64_t>& totalCosts) {
+    std::size_t rowCount = transposed ? costs.ncols() : costs.nrows();
+    std::size_t columnCount = transposed ? costs.nrows() : costs.ncols();
+    if (row == rowCount) {
+        totalCosts.push_back(partialCost);
+        return;
+    }
+    for (std::size_t col = 0; col < columnCount; col++) {
+        if (!isColumnUsed[col]) {
+            isColumnUsed[col] = true;
+            int cost = transposed ? costs(col, row) : costs(row, col);
+            enumerate_assignments(costs, transposed, row + 1, partialCost + cost, isColumnUsed, totalCosts);
+            isColumnUsed[col] = false;
+        }
+    }
+}
+
+// Costs of all assignments of min(n, m) pairs (all injections of the smaller side), ascending
+std::vector<int64_t> brute_force_costs(const Matrix<int>& costs) {
+    bool transposed = costs.nrows() > costs.ncols();
+    std::vector<bool> isColumnUsed(transposed ? costs.nrows() : costs.ncols(), false);
+    std::vector<int64_t> totalCosts;
+    enumerate_assignments(costs, transposed, 0, 0, isColumnUsed, totalCosts);
+    std::sort(totalCosts.begin(), totalCosts.end());
+    return totalCosts;
+}
+
+// Sum of costs(row, rowToColumn[row]) over the assigned rows
+int64_t cost_of(const Matrix<int>& costs, const std::vector<int>& rowToColumn) {
+    int64_t totalCost = 0;
+    for (std::size_t row = 0; row < rowToColumn.size(); row++) {
+        if (rowToColumn[row] >= 0) {
+            totalCost += costs(row, static_cast<std::size_t>(rowToColumn[row]));
+        }
+    }
+    return totalCost;
+}
+
+// The k best assignments must have the k lowest brute-force costs, cheapest first, and each
+// reported total must match its row-to-column assignment
+bool check_k_best(const Matrix<int>& costs, const std::vector<int64_t>& allCosts, std::size_t k) {
+    std::vector<AssignmentResult<int>> best = k_best_assignments(costs, k);
+    if (best.size() != std::min(k, allCosts.size())) {
+        return false;
+    }
+    for (std::size_t index = 0; index < best.size(); index++) {
+        if (best[index].totalCost != allCosts[index] || cost_of(costs, best[index].rowToColumn) != allCosts[index]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Rows x columns corner of a square instance
+Matrix<int> corner(const Matrix<int>& costs, std::size_t rowCount, std::size_t columnCount) {
+    return Matrix<int>(costs.block(0, 0, rowCount, columnCount));
+}
+
+// Builds a matrix from rows of equal length (at least one)
+Matrix<int> matrix_of(const std::vector<std::vector<int>>& rows) {
+    Matrix<int> costs(rows.size(), rows.front().size());
+    for (std::size_t row = 0; row < rows.size(); row++) {
+        std::copy(rows[row].begin(), rows[row].end(), costs.row(row).begin());
+    }
+    return costs;
+}
+
+// Starts an IncrementalAssignment from `rowCount` random rows (possibly none) and applies random
+// update_cost / add_row / remove_row calls to it and to a plain copy of its costs; after every call
+// its assignment must have the brute-force optimal cost of the copy, as must a fresh solve
+bool check_incremental_replay(std::size_t rowCount, std::size_t columnCount, int steps, std::mt19937& generator) {
+    std::uniform_int_distribution<int> costDistribution(0, 20);
+    std::vector<std::vector<int>> rows(rowCount, std::vector<int>(columnCount));
+    for (std::vector<int>& row : rows) {
+        for (int& cost : row) cost = costDistribution(generator);
+    }
+    IncrementalAssignment<int> incremental = rows.empty() ? IncrementalAssignment<int>(columnCount)
+                                                          : IncrementalAssignment<int>(matrix_of(rows));
+
+    std::uniform_int_distribution<int> operationDistribution(0, 3);
+    for (int step = 0; step < steps; step++) {
+        int operation = operationDistribution(generator);
+        if (operation <= 1 && !rows.empty()) {
+            std::size_t row = std::uniform_int_distribution<std::size_t>(0, rows.size() - 1)(generator);
+            std::size_t col = std::uniform_int_distribution<std::size_t>(0, columnCount - 1)(generator);
+            rows[row][col] = costDistribution(generator);
+            incremental.update_cost(row, col, rows[row][col]);
+        }
+        else if (operation == 2 && rows.size() < columnCount) {
+            std::vector<int> newRow(columnCount);
+            for (int& cost : newRow) cost = costDistribution(generator);
+            incremental.add_row(newRow);
+            rows.push_back(std::move(newRow));
+        }
+        else if (!rows.empty()) {
+            std::size_t row = std::uniform_int_distribution<std::size_t>(0, rows.size() - 1)(generator);
+            incremental.remove_row(row);
+            rows.erase(rows.begin() + static_cast<std::ptrdiff_t>(row));
+        }
+
+        AssignmentResult<int> current = incremental.result();
+        if (rows.empty()) {
+            if (current.totalCost != 0 || !current.rowToColumn.empty()) {
+                return false;
+            }
+            continue;
+        }
+        Matrix<int> costs = matrix_of(rows);
+        int64_t optimalCost = brute_force_costs(costs).front();
+        if (current.totalCost != optimalCost || cost_of(costs, current.rowToColumn) != optimalCost ||
+            solve_assignment(costs).totalCost != optimalCost) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Restarts the peak resident set size measurement where the platform allows it (Linux)
+void reset_peak_rss() {
+#if defined(__linux__)
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+#endif
+}
+
+// Peak resident set size in KiB since the last reset (since process start if it cannot be reset),
+// 0 where unsupported
+long peak_rss_kib() {
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::stol(line.substr(6));
+        }
+    }
+    return 0;
+#elif defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+Options parse_options(int argc, const char* argv[]) {
+    Options options;
+    for (int argIndex = 1; argIndex < argc; argIndex++) {
+        std::string argument = argv[argIndex];
+        if (argIndex + 1 >= argc) {
+            std::cerr << "Missing value for " << argument << std::endl;
+            std::exit(1);
+        }
+        std::string value = argv[++argIndex];
+        if (argument == "--seed") {
+            options.seed = static_cast<unsigned int>(std::stoul(value));
+        }
+        else if (argument == "--max-n") {
+            options.maxSize = std::stoul(value);
+        }
+        else if (argument == "--munkres-max-n") {
+            options.munkresMaxSize = std::stoul(value);
+        }
+        else {
+            std::cerr << "usage: a4_assignment_suite [--seed S] [--max-n N] [--munkres-max-n N]" << std::endl;
+            std::exit(1);
+        }
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[]) {
+    Options options = parse_options(argc, argv);
+    std::mt19937 generator(options.seed);
+
+    const NamedGenerator generators[] = {
+        {"uniform", uniform_costs},
+        {"low-rank", low_rank_costs},
+        {"many-ties", many_ties_costs},
+        {"structured", structured_costs},
+        {"sparse", sparse_costs},
+        {"machol-wien", machol_wien_costs},
+        {"constant", constant_costs},
+    };
+    const std::vector<Solver> solvers = make_solvers(options);
+
+    // 1. Brute-force cross-check, 20 seeded instances per generator and size
+    const std::size_t kBest = 10;
+    std::size_t checkedInstances = 0;
+    for (const NamedGenerator& named : generators) {
+        for (std::size_t size = 1; size <= 8; size++) {
+            for (int repetition = 0; repetition < 20; repetition++) {
+                Instance instance = named.generate(size, generator);
+                std::vector<int64_t> allCosts = brute_force_costs(instance.costs);
+                int64_t optimalCost = allCosts.front();
+                for (const Solver& solver : solvers) {
+                    int64_t cost = solver.solve(instance);
+                    if (cost != optimalCost) {
+                        std::cerr << solver.name << " returned cost " << cost << " instead of " << optimalCost
+                            << " on a " << size << " x " << size << ' ' << named.name << " instance" << std::endl;
+                        return 1;
+                    }
+                }
+                if (!check_k_best(instance.costs, allCosts, kBest)) {
+                    std::cerr << "murty k=" << kBest << " does not match the " << kBest << " lowest costs on a "
+                        << size << " x " << size << ' ' << named.name << " instance" << std::endl;
+                    return 1;
+                }
+                checkedInstances++;
+            }
+        }
+    }
+
+    // Rectangular corners of square instances, 5 per generator and shape
+    std::size_t checkedRectangular = 0;
+    for (const NamedGenerator& named : generators) {
+        for (std::size_t rowCount = 1; rowCount <= 6; rowCount++) {
+            for (std::size_t columnCount = 1; columnCount <= 6; columnCount++) {
+                if (rowCount == columnCount) {
+                    continue;
+                }
+                for (int repetition = 0; repetition < 5; repetition++) {
+                    Matrix<int> costs = corner(named.generate(std::max(rowCount, columnCount), generator).costs,
+                        rowCount, columnCount);
+                    std::vector<int64_t> allCosts = brute_force_costs(costs);
+                    AssignmentResult<int> result = solve_assignment(costs);
+                    bool agrees = result.totalCost == allCosts.front() &&
+                        cost_of(costs, result.rowToColumn) == allCosts.front();
+                    if (agrees && rowCount < columnCount) {
+                        agrees = IncrementalAssignment<int>(costs).total_cost() == allCosts.front() &&
+                            check_k_best(costs, allCosts, kBest);
+                    }
+                    if (!agrees) {
+                        std::cerr << "rectangular solvers disagree with brute force on a " << rowCount << " x "
+                            << columnCount << ' ' << named.name << " instance" << std::endl;
+                        return 1;
+                    }
+                    checkedRectangular++;
+                }
+            }
+        }
+    }
+
+    // Incremental repairs: 20 random calls from every starting shape up to 6 columns
+    std::size_t checkedReplays = 0;
+    for (std::size_t columnCount = 1; columnCount <= 6; columnCount++) {
+        for (std::size_t rowCount = 0; rowCount <= columnCount; rowCount++) {
+            for (int repetition = 0; repetition < 5; repetition++) {
+                if (!check_incremental_replay(rowCount, columnCount, 20, generator)) {
+                    std::cerr << "incremental disagrees with a fresh solve after updates from a " << rowCount
+                        << " x " << columnCount << " instance" << std::endl;
+                    return 1;
+                }
+                checkedReplays++;
+            }
+        }
+    }
+
+    // The sparse solver must report, not loop on, an instance without complete assignment
+    {
+        std::vector<AssignmentEdge<int>> edges = {{0, 0, 1}, {1, 0, 2}, {2, 1, 3}, {2, 2, 4}};
+        if (solve_sparse_assignment(SparseCostMatrix<int>(3, 3, edges)).feasible) {
+            std::cerr << "auction (sparse) did not report an infeasible instance" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "brute-force cross-check: " << checkedInstances << " instances x " << solvers.size()
+        << " solvers and murty k=" << kBest << ", " << checkedRectangular << " rectangular instances, "
+        << checkedReplays << " incremental replays OK\n\n";
+
+    // 2. Timing and peak memory
+    std::cout << std::left << std::setw(12) << "generator" << std::right << std::setw(6) << "n" << "  "
+        << std::left << std::setw(20) << "solver" << std::right << std::setw(16) << "cost"
+        << std::setw(12) << "time [s]" << std::setw(16) << "peak RSS [KiB]" << '\n';
+
+    for (const NamedGenerator& named : generators) {
+        for (std::size_t size = 100; size <= options.maxSize; size *= 3) {
+            Instance instance = named.generate(size, generator);
+            int64_t referenceCost = solve_assignment(instance.costs).totalCost;
+
+            for (const Solver& solver : solvers) {
+                if (size > solver.maxSize) {
+                    continue;
+                }
+                reset_peak_rss();
+                auto start = std::chrono::steady_clock::now();
+                int64_t cost = solver.solve(instance);
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                long peakRss = peak_rss_kib();
+
+                std::cout << std::left << std::setw(12) << named.name << std::right << std::setw(6) << size << "  "
+                    << std::left << std::setw(20) << solver.name << std::right << std::setw(16) << cost
+                    << std::fixed << std::setprecision(4) << std::setw(12) << seconds
+                    << std::setw(16) << peakRss << std::endl;
+
+                if (cost != referenceCost) {
+                    std::cerr << solver.name << " disagrees with jonker-volgenant (" << referenceCost << ") on "
+                        << named.name << " n = " << size << std::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
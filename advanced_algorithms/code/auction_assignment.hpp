@@ -0,0 +1,567 @@
+#ifndef AUCTION_ASSIGNMENT_HPP
+#define AUCTION_ASSIGNMENT_HPP
+
+#include <algorithm>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "assignment_solver.hpp"
+
+// Auction algorithm for the assignment problem (Bertsekas): a sparse solver and a multi-threaded
+// dense one
+// Rows bid for columns: an unassigned row takes the column with the best value (benefit minus
+// price) and raises its price by the gap to the second-best value plus epsilon, evicting the
+// previous owner. Every assignment then stays within epsilon of each row's best value
+// (epsilon-complementary slackness), and the final matching is within n * epsilon of optimal.
+// Epsilon scaling: a coarse epsilon settles the prices quickly, then it shrinks by a fixed
+// factor per phase, reusing the prices, until it reaches the final value.
+// The sparse solver only touches the allowed pairs, so a matrix with 99% forbidden entries
+// costs 1% of a dense solve.
+
+// One allowed (row, column) pair and its cost
+template <AssignmentCost Cost>
+struct AssignmentEdge {
+    std::size_t row;
+    std::size_t column;
+    Cost cost;
+};
+
+// SparseCostMatrix class template
+// Allowed pairs of an n x m assignment problem in compressed sparse row (CSR) form: the edges of
+// row r are edgeStart[r] .. edgeStart[r + 1] - 1 of edgeColumns / edgeCosts. Missing pairs are
+// forbidden.
+template <AssignmentCost Cost>
+class SparseCostMatrix {
+public:
+    // Thrown when the shape or an index is invalid
+    class Invalid {};
+
+    // Constructor: builds the CSR arrays from an edge list in any order
+    // Throws Invalid if the shape is empty or an edge lies outside it
+    SparseCostMatrix(std::size_t rowCount, std::size_t columnCount, std::span<const AssignmentEdge<Cost>> edges)
+        : rowCount_(rowCount), columnCount_(columnCount), edgeStart_(rowCount + 1, 0),
+        edgeColumns_(edges.size()), edgeCosts_(edges.size()) {
+
+        if (rowCount == 0 || columnCount == 0) {
+            throw Invalid{};
+        }
+
+        // Counting sort by row
+        for (const AssignmentEdge<Cost>& edge : edges) {
+            if (edge.row >= rowCount || edge.column >= columnCount) {
+                throw Invalid{};
+            }
+            edgeStart_[edge.row + 1]++;
+        }
+        for (std::size_t row = 0; row < rowCount; row++) {
+            edgeStart_[row + 1] += edgeStart_[row];
+        }
+
+        std::vector<std::size_t> nextSlot(edgeStart_.begin(), edgeStart_.end() - 1);
+        for (const AssignmentEdge<Cost>& edge : edges) {
+            std::size_t slot = nextSlot[edge.row]++;
+            edgeColumns_[slot] = static_cast<uint32_t>(edge.column);
+            edgeCosts_[slot] = edge.cost;
+        }
+    }
+
+    // Constructor: takes ready-made CSR arrays
+    // Throws Invalid unless edgeStart holds rowCount + 1 non-decreasing offsets from 0 to the
+    // number of edges and every column is in range
+    SparseCostMatrix(std::size_t rowCount, std::size_t columnCount, std::vector<std::size_t> edgeStart,
+        std::vector<uint32_t> edgeColumns, std::vector<Cost> edgeCosts)
+        : rowCount_(rowCount), columnCount_(columnCount), edgeStart_(std::move(edgeStart)),
+        edgeColumns_(std::move(edgeColumns)), edgeCosts_(std::move(edgeCosts)) {
+
+        if (rowCount == 0 || columnCount == 0 || edgeStart_.size() != rowCount + 1 || edgeStart_.front() != 0 ||
+            edgeStart_.back() != edgeColumns_.size() || edgeColumns_.size() != edgeCosts_.size() ||
+            !std::is_sorted(edgeStart_.begin(), edgeStart_.end()) ||
+            std::any_of(edgeColumns_.begin(), edgeColumns_.end(),
+                [columnCount](uint32_t column) { return column >= columnCount; })) {
+            throw Invalid{};
+        }
+    }
+
+    // Getter for number of rows
+    std::size_t nrows() const { return rowCount_; }
+
+    // Getter for number of columns
+    std::size_t ncols() const { return columnCount_; }
+
+    // Number of allowed pairs
+    std::size_t edge_count() const { return edgeColumns_.size(); }
+
+    // Edges of `row` are [row_begin(row), row_end(row))
+    std::size_t row_begin(std::size_t row) const { return edgeStart_[row]; }
+    std::size_t row_end(std::size_t row) const { return edgeStart_[row + 1]; }
+
+    // Column and cost of an edge
+    std::size_t column(std::size_t edge) const { return edgeColumns_[edge]; }
+    Cost cost(std::size_t edge) const { return edgeCosts_[edge]; }
+
+private:
+    std::size_t rowCount_;
+    std::size_t columnCount_;
+    std::vector<std::size_t> edgeStart_;   // rowCount + 1 offsets into the edge arrays
+    std::vector<uint32_t> edgeColumns_;    // column of each edge
+    std::vector<Cost> edgeCosts_;          // cost of each edge
+};
+
+namespace assignment_detail {
+
+// Epsilon shrinks by this factor per scaling phase
+template <AssignmentCost Cost>
+inline constexpr AssignmentSum<Cost> epsilonScalingFactor = 4;
+
+// Last epsilon of the scaling: 1 for integer costs (scaled by n + 1, so the result is exact),
+// about 1e-9 of the benefit range spread over the n rows for floating-point costs
+template <AssignmentCost Cost>
+AssignmentSum<Cost> final_epsilon(AssignmentSum<Cost> benefitRange, std::size_t matrixSize) {
+    if constexpr (std::is_integral_v<Cost>) {
+        return 1;
+    }
+    else {
+        return benefitRange > 0 ? benefitRange * 1e-9 / static_cast<AssignmentSum<Cost>>(matrixSize) : 1.0;
+    }
+}
+
+// Maximum cardinality matching of the allowed pairs (Hopcroft-Karp, O(E sqrt(V)))
+// Returns the column matched to each row, or `unassigned`
+template <AssignmentCost Cost>
+std::vector<std::size_t> maximum_matching(const SparseCostMatrix<Cost>& costs) {
+    const std::size_t rowCount = costs.nrows();
+    const std::size_t unreached = std::numeric_limits<std::size_t>::max();
+
+    std::vector<std::size_t> columnOfRow(rowCount, unassigned);
+    std::vector<std::size_t> rowOfColumn(costs.ncols(), unassigned);
+    std::vector<std::size_t> layer(rowCount);
+    std::vector<std::size_t> nextEdge(rowCount);
+    std::vector<std::size_t> queue;
+    std::vector<std::size_t> path;
+    queue.reserve(rowCount);
+
+    while (true) {
+        // BFS from all free rows, layering rows by alternating path length
+        queue.clear();
+        for (std::size_t row = 0; row < rowCount; row++) {
+            layer[row] = columnOfRow[row] == unassigned ? 0 : unreached;
+            if (columnOfRow[row] == unassigned) {
+                queue.push_back(row);
+            }
+        }
+        bool freeColumnReached = false;
+        for (std::size_t queueIndex = 0; queueIndex < queue.size(); queueIndex++) {
+            std::size_t row = queue[queueIndex];
+            for (std::size_t edge = costs.row_begin(row); edge < costs.row_end(row); edge++) {
+                std::size_t owner = rowOfColumn[costs.column(edge)];
+                if (owner == unassigned) {
+                    freeColumnReached = true;
+                }
+                else if (layer[owner] == unreached) {
+                    layer[owner] = layer[row] + 1;
+                    queue.push_back(owner);
+                }
+            }
+        }
+        if (!freeColumnReached) {
+            return columnOfRow;
+        }
+
+        // Vertex-disjoint shortest augmenting paths along the layers (iterative DFS)
+        for (std::size_t row = 0; row < rowCount; row++) {
+            nextEdge[row] = costs.row_begin(row);
+        }
+        for (std::size_t root = 0; root < rowCount; root++) {
+            if (columnOfRow[root] != unassigned) {
+                continue;
+            }
+            path.assign(1, root);
+            while (!path.empty()) {
+                std::size_t row = path.back();
+                if (nextEdge[row] == costs.row_end(row)) {
+                    layer[row] = unreached; // dead end, never try this row again in this round
+                    path.pop_back();
+                    if (!path.empty()) {
+                        nextEdge[path.back()]++;
+                    }
+                    continue;
+                }
+                std::size_t owner = rowOfColumn[costs.column(nextEdge[row])];
+                if (owner == unassigned) {
+                    // Augment: every row on the path takes the column its current edge points to
+                    for (std::size_t pathRow : path) {
+                        std::size_t column = costs.column(nextEdge[pathRow]);
+                        columnOfRow[pathRow] = column;
+                        rowOfColumn[column] = pathRow;
+                    }
+                    break;
+                }
+                if (layer[owner] != unreached && layer[owner] == layer[row] + 1) {
+                    path.push_back(owner);
+                }
+                else {
+                    nextEdge[row]++;
+                }
+            }
+        }
+    }
+}
+
+} // namespace assignment_detail
+
+// Solves the assignment problem on the allowed pairs of a square sparse cost matrix by
+// epsilon-scaling auction
+// Integer costs are scaled by n + 1 internally so the final epsilon of 1 gives an exact optimum;
+// floating-point costs end within about 1e-9 of the cost range of optimal. If the allowed pairs
+// admit no complete assignment, the result has feasible == false and holds a maximum matching
+// (rows left out get -1) instead of running the auction.
+// Throws SparseCostMatrix<Cost>::Invalid if the matrix is not square
+template <AssignmentCost Cost>
+AssignmentResult<Cost> solve_sparse_assignment(const SparseCostMatrix<Cost>& costs) {
+    using Sum = AssignmentSum<Cost>;
+
+    if (costs.nrows() != costs.ncols()) {
+        throw typename SparseCostMatrix<Cost>::Invalid{};
+    }
+
+    const std::size_t matrixSize = costs.nrows();
+    const std::size_t unassigned = assignment_detail::unassigned;
+
+    AssignmentResult<Cost> result;
+    result.rowToColumn.assign(matrixSize, -1);
+
+    // A complete assignment exists iff a maximum matching covers every row; without one the
+    // auction would raise prices forever
+    std::vector<std::size_t> columnOfRow = assignment_detail::maximum_matching(costs);
+    if (std::count(columnOfRow.begin(), columnOfRow.end(), unassigned) > 0) {
+        result.feasible = false;
+        for (std::size_t row = 0; row < matrixSize; row++) {
+            if (columnOfRow[row] == unassigned) {
+                continue;
+            }
+            result.rowToColumn[row] = static_cast<int>(columnOfRow[row]);
+            for (std::size_t edge = costs.row_begin(row); edge < costs.row_end(row); edge++) {
+                if (costs.column(edge) == columnOfRow[row]) {
+                    result.totalCost += static_cast<Sum>(costs.cost(edge));
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+    // Benefit = negated (and, for integers, scaled) cost, so the auction maximizes
+    const Sum costScale = std::is_integral_v<Cost> ? static_cast<Sum>(matrixSize + 1) : Sum{1};
+    std::vector<Sum> benefit(costs.edge_count());
+    Sum smallestBenefit = std::numeric_limits<Sum>::max();
+    Sum largestBenefit = std::numeric_limits<Sum>::lowest();
+    for (std::size_t edge = 0; edge < costs.edge_count(); edge++) {
+        benefit[edge] = -static_cast<Sum>(costs.cost(edge)) * costScale;
+        smallestBenefit = std::min(smallestBenefit, benefit[edge]);
+        largestBenefit = std::max(largestBenefit, benefit[edge]);
+    }
+    const Sum benefitRange = largestBenefit - smallestBenefit;
+
+    const Sum finalEpsilon = assignment_detail::final_epsilon<Cost>(benefitRange, matrixSize);
+    Sum epsilon = std::max(finalEpsilon, benefitRange / assignment_detail::epsilonScalingFactor<Cost>);
+
+    std::vector<Sum> price(matrixSize, 0);
+    std::vector<std::size_t> ownerOfColumn(matrixSize);
+    std::vector<std::size_t> assignedEdge(matrixSize);
+    std::vector<std::size_t> unassignedRows;
+    unassignedRows.reserve(matrixSize);
+
+    while (true) {
+        // Each phase starts from an empty assignment but keeps the prices of the previous one
+        std::fill(ownerOfColumn.begin(), ownerOfColumn.end(), unassigned);
+        unassignedRows.clear();
+        for (std::size_t row = matrixSize; row-- > 0;) {
+            unassignedRows.push_back(row);
+        }
+
+        // Gauss-Seidel bidding: one row at a time, prices update immediately
+        while (!unassignedRows.empty()) {
+            std::size_t row = unassignedRows.back();
+            unassignedRows.pop_back();
+
+            std::size_t bestEdge = costs.row_begin(row);
+            Sum bestValue = std::numeric_limits<Sum>::lowest();
+            Sum secondValue = std::numeric_limits<Sum>::lowest();
+            for (std::size_t edge = costs.row_begin(row); edge < costs.row_end(row); edge++) {
+                Sum value = benefit[edge] - price[costs.column(edge)];
+                if (value > bestValue) {
+                    secondValue = bestValue;
+                    bestValue = value;
+                    bestEdge = edge;
+                }
+                else if (value > secondValue) {
+                    secondValue = value;
+                }
+            }
+            // A row with a single allowed column may outbid anyone for it
+            if (secondValue == std::numeric_limits<Sum>::lowest()) {
+                secondValue = bestValue - benefitRange - epsilon;
+            }
+
+            std::size_t column = costs.column(bestEdge);
+            price[column] += bestValue - secondValue + epsilon;
+            if (ownerOfColumn[column] != unassigned) {
+                unassignedRows.push_back(ownerOfColumn[column]);
+            }
+            ownerOfColumn[column] = row;
+            assignedEdge[row] = bestEdge;
+        }
+
+        if (epsilon <= finalEpsilon) {
+            break;
+        }
+        epsilon = std::max(finalEpsilon, epsilon / assignment_detail::epsilonScalingFactor<Cost>);
+    }
+
+    for (std::size_t column = 0; column < matrixSize; column++) {
+        std::size_t row = ownerOfColumn[column];
+        result.rowToColumn[row] = static_cast<int>(column);
+        result.totalCost += static_cast<Sum>(costs.cost(assignedEdge[row]));
+    }
+    return result;
+}
+
+// Solves the assignment problem for a dense square cost matrix by epsilon-scaling auction, with
+// the bidding spread over `threadCount` threads (0 = one per hardware thread)
+// Jacobi rounds: every unassigned row computes its bid against the same prices. The bids are
+// then resolved in ascending row order; each column goes to the highest bid, ties to the lowest
+// row index. A round with many bidders is split into contiguous slices of the bidders; once
+// there are fewer bidders than threads (the long tail of every phase), each bidder's column scan
+// is split into contiguous column slices instead, so all threads stay busy down to the last bid.
+// Rounds too small to pay for a barrier run on the calling thread. The split only decides who
+// computes a bid, never its value, so the result is the same for any number of threads.
+// Accuracy is as for solve_sparse_assignment (exact for integer costs).
+// Throws Matrix<Cost>::Invalid if the matrix is not square
+template <AssignmentCost Cost>
+AssignmentResult<Cost> solve_parallel_auction(const Matrix<Cost>& costMatrix, unsigned int threadCount = 0) {
+    using Sum = AssignmentSum<Cost>;
+
+    if (costMatrix.nrows() != costMatrix.ncols()) {
+        throw typename Matrix<Cost>::Invalid{};
+    }
+
+    const std::size_t matrixSize = costMatrix.nrows();
+    const std::size_t unassigned = assignment_detail::unassigned;
+    const std::size_t serialRoundElements = 1 << 14; // cost entries a round must scan to go parallel
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Benefit = negated (and, for integers, scaled) cost, so the auction maximizes
+    const Sum costScale = std::is_integral_v<Cost> ? static_cast<Sum>(matrixSize + 1) : Sum{1};
+    Sum smallestCost = static_cast<Sum>(costMatrix(0, 0));
+    Sum largestCost = smallestCost;
+    for (std::size_t row = 0; row < matrixSize; row++) {
+        for (std::size_t column = 0; column < matrixSize; column++) {
+            smallestCost = std::min(smallestCost, static_cast<Sum>(costMatrix(row, column)));
+            largestCost = std::max(largestCost, static_cast<Sum>(costMatrix(row, column)));
+        }
+    }
+    const Sum benefitRange = (largestCost - smallestCost) * costScale;
+    const Sum finalEpsilon = assignment_detail::final_epsilon<Cost>(benefitRange, matrixSize);
+    Sum epsilon = std::max(finalEpsilon, benefitRange / assignment_detail::epsilonScalingFactor<Cost>);
+
+    std::vector<Sum> price(matrixSize, 0);
+    std::vector<std::size_t> ownerOfColumn(matrixSize);
+
+    // Best and second-best value of one row over a range of columns
+    struct Scan {
+        std::size_t bestColumn;
+        Sum bestValue;
+        Sum secondValue;
+    };
+
+    // Bid of one row: the column it wants and the price it offers
+    struct Bid {
+        std::size_t column;
+        Sum amount;
+    };
+
+    // Scans columns [begin, end) of `row` at the current prices; equal values go to the lowest column
+    auto scan_columns = [&](std::size_t row, std::size_t begin, std::size_t end) {
+        Scan scan{begin, std::numeric_limits<Sum>::lowest(), std::numeric_limits<Sum>::lowest()};
+        for (std::size_t column = begin; column < end; column++) {
+            Sum value = -static_cast<Sum>(costMatrix(row, column)) * costScale - price[column];
+            if (value > scan.bestValue) {
+                scan.secondValue = scan.bestValue;
+                scan.bestValue = value;
+                scan.bestColumn = column;
+            }
+            else if (value > scan.secondValue) {
+                scan.secondValue = value;
+            }
+        }
+        return scan;
+    };
+
+    // Appends the scan of the next column range; the same result as scanning both ranges at once
+    auto merge_scans = [](Scan& scan, const Scan& next) {
+        if (next.bestValue > scan.bestValue) {
+            scan.secondValue = std::max(scan.bestValue, next.secondValue);
+            scan.bestValue = next.bestValue;
+            scan.bestColumn = next.bestColumn;
+        }
+        else {
+            scan.secondValue = std::max(scan.secondValue, next.bestValue);
+        }
+    };
+
+    // The price that keeps the best column of a full-row scan epsilon-optimal
+    auto bid_from_scan = [&](Scan scan) {
+        if (matrixSize == 1) {
+            scan.secondValue = scan.bestValue - benefitRange - epsilon;
+        }
+        return Bid{scan.bestColumn, price[scan.bestColumn] + scan.bestValue - scan.secondValue + epsilon};
+    };
+
+    std::vector<std::size_t> bidders;            // unassigned rows of the current round, ascending
+    std::vector<std::size_t> nextBidders;
+    std::vector<std::size_t> evictedRows;
+    std::vector<Bid> bids(matrixSize);           // bids[i] is the bid of bidders[i]
+    std::vector<Scan> sliceScans(static_cast<std::size_t>(threadCount) * threadCount); // [bidder][thread]
+    std::vector<std::size_t> winningBid(matrixSize, unassigned); // index into bids per column, this round
+    std::vector<std::size_t> contestedColumns;
+    bidders.reserve(matrixSize);
+    nextBidders.reserve(matrixSize);
+    evictedRows.reserve(matrixSize);
+    contestedColumns.reserve(matrixSize);
+
+    // Workers wait at the barrier for a round, do their share and meet again; the calling
+    // thread is worker 0 and does everything sequential in between
+    std::barrier roundBarrier(static_cast<std::ptrdiff_t>(threadCount));
+    bool finished = false;
+    bool splitColumns = false; // set by worker 0 before each round
+
+    auto bid_for_share = [&](unsigned int threadIndex) {
+        if (!splitColumns) {
+            std::size_t begin = bidders.size() * threadIndex / threadCount;
+            std::size_t end = bidders.size() * (threadIndex + 1) / threadCount;
+            for (std::size_t bidIndex = begin; bidIndex < end; bidIndex++) {
+                bids[bidIndex] = bid_from_scan(scan_columns(bidders[bidIndex], 0, matrixSize));
+            }
+            return;
+        }
+        std::size_t begin = matrixSize * threadIndex / threadCount;
+        std::size_t end = matrixSize * (threadIndex + 1) / threadCount;
+        for (std::size_t bidIndex = 0; bidIndex < bidders.size(); bidIndex++) {
+            sliceScans[bidIndex * threadCount + threadIndex] = scan_columns(bidders[bidIndex], begin, end);
+        }
+    };
+
+    std::vector<std::jthread> workers;
+    workers.reserve(threadCount - 1);
+    for (unsigned int threadIndex = 1; threadIndex < threadCount; threadIndex++) {
+        workers.emplace_back([&, threadIndex] {
+            while (true) {
+                roundBarrier.arrive_and_wait();
+                if (finished) {
+                    return;
+                }
+                bid_for_share(threadIndex);
+                roundBarrier.arrive_and_wait();
+            }
+        });
+    }
+
+    while (true) {
+        // Each phase starts from an empty assignment but keeps the prices of the previous one
+        std::fill(ownerOfColumn.begin(), ownerOfColumn.end(), unassigned);
+        bidders.resize(matrixSize);
+        for (std::size_t row = 0; row < matrixSize; row++) {
+            bidders[row] = row;
+        }
+
+        // Jacobi rounds
+        while (!bidders.empty()) {
+            if (threadCount == 1 || bidders.size() * matrixSize < serialRoundElements) {
+                for (std::size_t bidIndex = 0; bidIndex < bidders.size(); bidIndex++) {
+                    bids[bidIndex] = bid_from_scan(scan_columns(bidders[bidIndex], 0, matrixSize));
+                }
+            }
+            else {
+                splitColumns = bidders.size() < threadCount;
+                roundBarrier.arrive_and_wait();
+                bid_for_share(0);
+                roundBarrier.arrive_and_wait();
+
+                // Column slices are merged in ascending order, so ties still go to the lowest column
+                if (splitColumns) {
+                    for (std::size_t bidIndex = 0; bidIndex < bidders.size(); bidIndex++) {
+                        Scan scan = sliceScans[bidIndex * threadCount];
+                        for (unsigned int threadIndex = 1; threadIndex < threadCount; threadIndex++) {
+                            merge_scans(scan, sliceScans[bidIndex * threadCount + threadIndex]);
+                        }
+                        bids[bidIndex] = bid_from_scan(scan);
+                    }
+                }
+            }
+
+            // Highest bid per column; bidders are ascending, so a tie keeps the lower row
+            contestedColumns.clear();
+            for (std::size_t bidIndex = 0; bidIndex < bidders.size(); bidIndex++) {
+                std::size_t column = bids[bidIndex].column;
+                if (winningBid[column] == unassigned) {
+                    winningBid[column] = bidIndex;
+                    contestedColumns.push_back(column);
+                }
+                else if (bids[bidIndex].amount > bids[winningBid[column]].amount) {
+                    winningBid[column] = bidIndex;
+                }
+            }
+
+            // Losers (still ascending) and evicted owners bid again next round; the two sets are
+            // disjoint, since owners were not bidding, and are merged into ascending row order
+            nextBidders.clear();
+            for (std::size_t bidIndex = 0; bidIndex < bidders.size(); bidIndex++) {
+                if (winningBid[bids[bidIndex].column] != bidIndex) {
+                    nextBidders.push_back(bidders[bidIndex]);
+                }
+            }
+            evictedRows.clear();
+            for (std::size_t column : contestedColumns) {
+                if (ownerOfColumn[column] != unassigned) {
+                    evictedRows.push_back(ownerOfColumn[column]);
+                }
+                ownerOfColumn[column] = bidders[winningBid[column]];
+                price[column] = bids[winningBid[column]].amount;
+                winningBid[column] = unassigned;
+            }
+            std::sort(evictedRows.begin(), evictedRows.end());
+            std::size_t loserCount = nextBidders.size();
+            nextBidders.insert(nextBidders.end(), evictedRows.begin(), evictedRows.end());
+            std::inplace_merge(nextBidders.begin(),
+                nextBidders.begin() + static_cast<std::ptrdiff_t>(loserCount), nextBidders.end());
+            bidders.swap(nextBidders);
+        }
+
+        if (epsilon <= finalEpsilon) {
+            break;
+        }
+        epsilon = std::max(finalEpsilon, epsilon / assignment_detail::epsilonScalingFactor<Cost>);
+    }
+
+    finished = true;
+    roundBarrier.arrive_and_wait(); // release the workers; the jthreads join on destruction
+
+    AssignmentResult<Cost> result;
+    result.rowToColumn.assign(matrixSize, -1);
+    for (std::size_t column = 0; column < matrixSize; column++) {
+        std::size_t row = ownerOfColumn[column];
+        result.rowToColumn[row] = static_cast<int>(column);
+        result.totalCost += static_cast<Sum>(costMatrix(row, column));
+    }
+    return result;
+}
+
+#endif  // AUCTION_ASSIGNMENT_HPP
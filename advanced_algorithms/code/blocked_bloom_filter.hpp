@@ -0,0 +1,284 @@
+#ifndef BLOCKED_BLOOM_FILTER_HPP
+#define BLOCKED_BLOOM_FILTER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <vector>
+#include "bloom_common.hpp"
+#include "bloom_file.hpp"
+
+// BlockedBloomFilter class template
+// Same interface as BloomFilter, but all bits of one key live in a single 64-byte block
+// (one cache line) chosen by the first hash, so a lookup costs one memory access
+// instead of one per hash function.
+// Key: type of elements stored
+// numBits: requested size of the bit array (rounded up to whole 512-bit blocks)
+// HashFunction: hashing strategy (defaults to DefaultBloomHash, see bloom_common.hpp)
+template <typename Key, unsigned int numBits, typename HashFunction = DefaultBloomHash<Key>>
+class BlockedBloomFilter {
+public:
+    static constexpr std::size_t bitsPerBlock = 512;                       // 64 bytes = one cache line
+    static constexpr std::size_t wordsPerBlock = bitsPerBlock / 64;
+    static constexpr std::size_t numBlocks = (numBits + bitsPerBlock - 1) / bitsPerBlock;
+    static constexpr std::size_t totalBits = numBlocks * bitsPerBlock;
+    static constexpr std::size_t batchGroupSize = 16; // keys hashed and prefetched together
+
+    static_assert(numBlocks > 0, "BlockedBloomFilter needs at least one bit");
+
+    // Constructor: Initializes Bloom filter with a given number of hash functions
+    explicit BlockedBloomFilter(unsigned int numberOfHashFunctions)
+        : numberOfHashFunctions_(numberOfHashFunctions) {
+        clear();
+    }
+
+    // Constructor that takes an initializer list (e.g., {1, 2, 3}) and inserts keys into the filter
+    BlockedBloomFilter(std::initializer_list<Key> initialKeys, unsigned int numberOfHashFunctions)
+        : numberOfHashFunctions_(numberOfHashFunctions) {
+        clear();
+        for (const Key& element : initialKeys) {
+            insert(element);
+        }
+    }
+
+    // Constructor that inserts keys using iterators from any container (e.g., vector, set)
+    template <typename Iterator>
+    BlockedBloomFilter(Iterator iteratorBegin, Iterator iteratorEnd, unsigned int numberOfHashFunctions)
+        : numberOfHashFunctions_(numberOfHashFunctions) {
+        clear();
+        for (Iterator current = iteratorBegin; current != iteratorEnd; ++current) {
+            insert(*current);
+        }
+    }
+
+    // Inserts a key into the Bloom filter
+    // Returns true if at least one new bit was set (i.e., changed from 0 to 1)
+    bool insert(const Key& element) {
+        BloomProbes<Key, HashFunction> probes(hasher_, element);
+        Block& block = blockStorage_[block_index(probes(0))];
+        bool atLeastOneBitNewlySet = false;
+
+        for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
+            std::size_t bitInBlock = bit_in_block(probes(hashIndex + 1));
+            uint64_t& word = block.words[bitInBlock / 64];
+            uint64_t mask = uint64_t{1} << (bitInBlock % 64);
+            if ((word & mask) == 0) {
+                atLeastOneBitNewlySet = true; // A new bit is set, which was previously 0
+            }
+            word |= mask;
+        }
+
+        return atLeastOneBitNewlySet;
+    }
+
+    // Checks if a key is *possibly* in the filter
+    // Only the block selected by the first hash is read
+    bool contains(const Key& element) const {
+        BloomProbes<Key, HashFunction> probes(hasher_, element);
+        const Block& block = blockStorage_[block_index(probes(0))];
+
+        for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
+            std::size_t bitInBlock = bit_in_block(probes(hashIndex + 1));
+            if ((block.words[bitInBlock / 64] & (uint64_t{1} << (bitInBlock % 64))) == 0) {
+                return false; // If any bit is 0, the key was not inserted
+            }
+        }
+        return true; // possibly in the set (could be a false positive)
+    }
+
+    // Inserts every key of the span
+    // A group of keys is hashed first and its blocks prefetched, then the bits are set
+    // Returns the number of keys that set at least one new bit
+    std::size_t insert_batch(std::span<const Key> elements) {
+        std::vector<std::size_t> blockIndices(batchGroupSize);
+        std::vector<std::size_t> bitsInBlock(batchGroupSize * numberOfHashFunctions_);
+        std::size_t newlyInsertedCount = 0;
+
+        for (std::size_t groupStart = 0; groupStart < elements.size(); groupStart += batchGroupSize) {
+            std::size_t groupSize = std::min(batchGroupSize, elements.size() - groupStart);
+            hash_group(elements.subspan(groupStart, groupSize), blockIndices, bitsInBlock);
+
+            for (std::size_t keyIndex = 0; keyIndex < groupSize; keyIndex++) {
+                bloom_prefetch_write(&blockStorage_[blockIndices[keyIndex]]);
+            }
+
+            for (std::size_t keyIndex = 0; keyIndex < groupSize; keyIndex++) {
+                Block& block = blockStorage_[blockIndices[keyIndex]];
+                bool atLeastOneBitNewlySet = false;
+                for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
+                    std::size_t bitInBlock = bitsInBlock[keyIndex * numberOfHashFunctions_ + hashIndex];
+                    uint64_t& word = block.words[bitInBlock / 64];
+                    uint64_t mask = uint64_t{1} << (bitInBlock % 64);
+                    if ((word & mask) == 0) {
+                        atLeastOneBitNewlySet = true;
+                    }
+                    word |= mask;
+                }
+                if (atLeastOneBitNewlySet) {
+                    newlyInsertedCount++;
+                }
+            }
+        }
+
+        return newlyInsertedCount;
+    }
+
+    // Looks up every key of the span; results[i] receives contains(elements[i])
+    void contains_batch(std::span<const Key> elements, std::span<bool> results) const {
+        assert(results.size() >= elements.size());
+        std::vector<std::size_t> blockIndices(batchGroupSize);
+        std::vector<std::size_t> bitsInBlock(batchGroupSize * numberOfHashFunctions_);
+
+        for (std::size_t groupStart = 0; groupStart < elements.size(); groupStart += batchGroupSize) {
+            std::size_t groupSize = std::min(batchGroupSize, elements.size() - groupStart);
+            hash_group(elements.subspan(groupStart, groupSize), blockIndices, bitsInBlock);
+
+            for (std::size_t keyIndex = 0; keyIndex < groupSize; keyIndex++) {
+                bloom_prefetch_read(&blockStorage_[blockIndices[keyIndex]]);
+            }
+
+            for (std::size_t keyIndex = 0; keyIndex < groupSize; keyIndex++) {
+                const Block& block = blockStorage_[blockIndices[keyIndex]];
+                bool possiblyPresent = true;
+                for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_ && possiblyPresent; hashIndex++) {
+                    std::size_t bitInBlock = bitsInBlock[keyIndex * numberOfHashFunctions_ + hashIndex];
+                    possiblyPresent = (block.words[bitInBlock / 64] >> (bitInBlock % 64)) & 1;
+                }
+                results[groupStart + keyIndex] = possiblyPresent;
+            }
+        }
+    }
+
+    // Calculate false positive rate over a set of keys known not to be in the filter
+    // (the positives are accepted for interface parity with BloomFilter)
+    template <typename Iterator>
+    double false_positive_rate(
+        Iterator /*knownPositivesBegin*/, Iterator /*knownPositivesEnd*/,
+        Iterator knownNegativesBegin, Iterator knownNegativesEnd) const {
+
+        uint64_t falsePositiveCount = 0;
+        uint64_t totalNegativeSamples = 0;
+
+        for (Iterator it = knownNegativesBegin; it != knownNegativesEnd; ++it) {
+            totalNegativeSamples++;
+            if (contains(*it)) {
+                falsePositiveCount++;
+            }
+        }
+
+        if (totalNegativeSamples == 0) return 0.0; // Avoid division by zero
+
+        return static_cast<double>(falsePositiveCount) / static_cast<double>(totalNegativeSamples);
+    }
+
+    // Compares space used by the filter vs. storing the keys themselves
+    double space_ratio(uint64_t expectedElementCount) const {
+        std::size_t actualBitMemory = sizeof(blockStorage_);
+        std::size_t optimalBitMemory = expectedElementCount * sizeof(Key);
+        return static_cast<double>(actualBitMemory) / static_cast<double>(optimalBitMemory);
+    }
+
+    // Estimates how many elements have been inserted, based on number of set bits
+    uint64_t approx_size() const {
+        return bloom_estimate_cardinality(count_set_bits(), totalBits, numberOfHashFunctions_);
+    }
+
+    // Number of bits set to 1, counted a word at a time
+    uint64_t count_set_bits() const {
+        return bloom_count_bits(words(), numBlocks * wordsPerBlock);
+    }
+
+    // Adds every key of `other` to this filter (bitwise OR of the blocks)
+    // Both filters must use the same number of hash functions
+    void merge(const BlockedBloomFilter& other) {
+        assert(numberOfHashFunctions_ == other.numberOfHashFunctions_);
+        bloom_merge_words(words(), other.words(), numBlocks * wordsPerBlock);
+    }
+
+    // Keeps only the bits set in both filters (bitwise AND)
+    void intersect(const BlockedBloomFilter& other) {
+        assert(numberOfHashFunctions_ == other.numberOfHashFunctions_);
+        bloom_intersect_words(words(), other.words(), numBlocks * wordsPerBlock);
+    }
+
+    // Estimated number of distinct keys in the union of both filters, without modifying either
+    uint64_t approx_union_size(const BlockedBloomFilter& other) const {
+        assert(numberOfHashFunctions_ == other.numberOfHashFunctions_);
+        return bloom_estimate_cardinality(
+            bloom_count_union_bits(words(), other.words(), numBlocks * wordsPerBlock),
+            totalBits, numberOfHashFunctions_);
+    }
+
+    // Estimated number of keys inserted into both filters
+    uint64_t approx_intersection_size(const BlockedBloomFilter& other) const {
+        return bloom_estimate_intersection(approx_size(), other.approx_size(), approx_union_size(other));
+    }
+
+    // Writes the filter to `path` in the versioned format of bloom_file.hpp,
+    // readable by MappedBloomFilter::open_mapped. Throws std::runtime_error on I/O failure
+    void save(const std::string& path) const requires PersistableHashPolicy<HashFunction> {
+        write_bloom_file(path,
+            make_bloom_file_header<Key, HashFunction>(BloomLayout::blocked, totalBits, numberOfHashFunctions_,
+                numBlocks * wordsPerBlock),
+            blockStorage_.data(), sizeof(blockStorage_));
+    }
+
+private:
+    // One cache line worth of bits
+    struct alignas(64) Block {
+        std::array<uint64_t, wordsPerBlock> words;
+    };
+
+    static_assert(sizeof(Block) == wordsPerBlock * sizeof(uint64_t), "blocks must not be padded");
+
+    // The blocks viewed as one contiguous run of words (blocks are unpadded cache lines)
+    uint64_t* words() { return blockStorage_.front().words.data(); }
+    const uint64_t* words() const { return blockStorage_.front().words.data(); }
+
+    // Resets every bit to 0
+    void clear() {
+        for (Block& block : blockStorage_) {
+            block.words.fill(0);
+        }
+    }
+
+    // The first probe picks the block
+    static std::size_t block_index(uint64_t probeHash) {
+        return reduce_range(probeHash, numBlocks);
+    }
+
+    // The remaining probes pick bits inside that block. Bits 32..40 of the probe hash are used:
+    // the block index comes from the top bits, and keys sharing a block must not also share
+    // their in-block pattern.
+    static std::size_t bit_in_block(uint64_t probeHash) {
+        return (probeHash >> 32) % bitsPerBlock;
+    }
+
+    // Computes the block and the in-block bits of a group of keys, key-major
+    void hash_group(std::span<const Key> group, std::vector<std::size_t>& blockIndices,
+        std::vector<std::size_t>& bitsInBlock) const {
+        // Probe 0 selects the block, probes 1..k the bits
+        bloom_probe_group(hasher_, group, numberOfHashFunctions_ + 1,
+            [&](std::size_t keyIndex, unsigned int probeIndex, uint64_t probeHash) {
+                if (probeIndex == 0) {
+                    blockIndices[keyIndex] = block_index(probeHash);
+                }
+                else {
+                    bitsInBlock[keyIndex * numberOfHashFunctions_ + probeIndex - 1] = bit_in_block(probeHash);
+                }
+            });
+    }
+
+    std::array<Block, numBlocks> blockStorage_; // Cache-line aligned blocks of bits
+    unsigned int numberOfHashFunctions_;        // Number of bits set per key
+    HashFunction hasher_;                       // hash function functor
+};
+
+#endif  // BLOCKED_BLOOM_FILTER_HPP
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "bloom_filter.hpp"
+#include "blocked_bloom_filter.hpp"
+
+// Compares the scalar insert/contains loops against insert_batch/contains_batch
+// for filters from cache-resident to DRAM-sized.
+// Every batch answer is checked against the scalar lookup; exits with status 1 on any mismatch.
+// usage: a4_bloom_batch_benchmark [number of queries]
+
+namespace {
+
+using Key = uint64_t;
+constexpr unsigned int numberOfHashFunctions = 7;
+
+// Million keys per second for `keyCount` keys processed in `elapsed`
+double throughput(std::size_t keyCount, std::chrono::steady_clock::duration elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    return static_cast<double>(keyCount) / seconds / 1e6;
+}
+
+// Runs `work` once and returns how long it took
+template <typename Work>
+std::chrono::steady_clock::duration time_it(Work&& work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    return std::chrono::steady_clock::now() - start;
+}
+
+// Benchmarks one filter type; inserted keys fill the filter to about 10 bits per key
+// (the largest filters stay sparser, the key pool is capped at 8M keys)
+// Returns false if a batch lookup disagrees with the scalar lookup of the same key
+template <typename Filter>
+bool run_filter(const char* filterName, std::size_t filterBits, const std::vector<Key>& keys,
+    const std::vector<Key>& queries) {
+
+    std::size_t insertedCount = std::min(keys.size(), filterBits / 10);
+    std::span<const Key> inserted(keys.data(), insertedCount);
+
+    // The filters are far too large for the stack
+    auto scalarFilter = std::make_unique<Filter>(numberOfHashFunctions);
+    auto batchFilter = std::make_unique<Filter>(numberOfHashFunctions);
+
+    auto scalarInsert = time_it([&] {
+        for (Key key : inserted) scalarFilter->insert(key);
+    });
+    auto batchInsert = time_it([&] {
+        batchFilter->insert_batch(inserted);
+    });
+
+    std::size_t scalarHits = 0;
+    auto scalarQuery = time_it([&] {
+        for (Key key : queries) {
+            if (scalarFilter->contains(key)) scalarHits++;
+        }
+    });
+
+    std::unique_ptr<bool[]> results = std::make_unique<bool[]>(queries.size());
+    auto batchQuery = time_it([&] {
+        batchFilter->contains_batch(queries, std::span<bool>(results.get(), queries.size()));
+    });
+
+    // Key by key: the batch-built filter queried in batches against the scalar-built filter queried one by one
+    std::size_t mismatchCount = 0;
+    std::size_t batchHits = 0;
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        if (results[i]) batchHits++;
+        if (results[i] != scalarFilter->contains(queries[i])) {
+            if (mismatchCount == 0) {
+                std::cerr << std::boolalpha << filterName << ": contains_batch gives " << results[i]
+                    << " for query " << i << " (key " << queries[i] << "), contains gives " << !results[i] << '\n';
+            }
+            mismatchCount++;
+        }
+    }
+    if (mismatchCount != 0 || batchHits != scalarHits) {
+        std::cerr << filterName << ": " << mismatchCount << " of " << queries.size()
+            << " batch lookups differ from the scalar lookups\n";
+    }
+
+    std::cout << std::left << std::setw(10) << filterName
+        << std::right << std::setw(10) << std::fixed << std::setprecision(1)
+        << static_cast<double>(filterBits) / 8.0 / (1 << 20)
+        << std::setw(14) << throughput(insertedCount, scalarInsert)
+        << std::setw(14) << throughput(insertedCount, batchInsert)
+        << std::setw(14) << throughput(queries.size(), scalarQuery)
+        << std::setw(16) << throughput(queries.size(), batchQuery) << '\n';
+
+    return mismatchCount == 0 && batchHits == scalarHits;
+}
+
+template <unsigned int numBits>
+bool run_size(const std::vector<Key>& keys, const std::vector<Key>& queries) {
+    bool plainAgrees = run_filter<BloomFilter<Key, numBits, BloomDoubleHash<Key>>>("plain", numBits, keys, queries);
+    bool blockedAgrees =
+        run_filter<BlockedBloomFilter<Key, numBits, BloomDoubleHash<Key>>>("blocked", numBits, keys, queries);
+    return plainAgrees && blockedAgrees;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[]) {
+    std::size_t queryCount = argc > 1 ? std::stoul(argv[1]) : 4'000'000;
+
+    // Random keys; half of the queries hit keys that every filter size has inserted
+    std::mt19937_64 generator(42);
+    std::vector<Key> keys(std::size_t{1} << 23);
+    for (Key& key : keys) key = generator();
+
+    std::vector<Key> queries(queryCount);
+    std::uniform_int_distribution<std::size_t> pick(0, (1u << 20) / 10 - 1);
+    for (std::size_t i = 0; i < queryCount; i++) {
+        queries[i] = (i % 2 == 0) ? keys[pick(generator)] : generator();
+    }
+
+    std::cout << "million keys per second, k = " << numberOfHashFunctions << '\n';
+    std::cout << std::left << std::setw(10) << "filter" << std::right << std::setw(10) << "MiB"
+        << std::setw(14) << "insert" << std::setw(14) << "insert_batch"
+        << std::setw(14) << "contains" << std::setw(16) << "contains_batch" << '\n';
+
+    bool agrees = true;
+    agrees &= run_size<(1u << 20)>(keys, queries);   // 128 KiB: fits in L2
+    agrees &= run_size<(1u << 24)>(keys, queries);   // 2 MiB: around L3
+    agrees &= run_size<(1u << 28)>(keys, queries);   // 32 MiB: beyond most L3 caches
+    agrees &= run_size<(1u << 30)>(keys, queries);   // 128 MiB: DRAM bound
+
+    return agrees ? EXIT_SUCCESS : EXIT_FAILURE;
+}
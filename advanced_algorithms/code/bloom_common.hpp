@@ -0,0 +1,412 @@
+#ifndef BLOOM_COMMON_HPP
+#define BLOOM_COMMON_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "murmurhash.hpp"
+#include "murmurhash_batch.hpp"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+// Hashing policies, probe and prefetch helpers shared by the Bloom filter family.
+//
+// A hashing policy is one of two shapes:
+//   seeded:       hasher(key, seed) -> std::size_t, called once per probe (BloomHash)
+//   double hash:  hasher(key) -> Hash128, called once per key; probe i is h1 + i * h2
+//                 (Kirsch & Mitzenmacher, "Less hashing, same performance")
+//
+// Filters default to DefaultBloomHash<Key>, which picks a policy from the key type at compile time:
+//   integers, floating point, enums  -> BloomHash (one inlined 32-bit Murmur pass per probe)
+//   std::string, std::string_view    -> BloomStringHash (hashes the characters)
+//   PackedKmer                       -> BloomKmerHash (two 64-bit finalizer rounds)
+//   other trivially copyable types   -> BloomBytesHash (hashes the object bytes)
+
+// A hash wrapper that applies MurmurHash using a given seed
+template <typename Key>
+struct BloomHash {
+    static_assert(std::is_trivially_copyable_v<Key>,
+        "BloomHash hashes the bytes of the key object; use DefaultBloomHash for strings and other owning types");
+
+    static constexpr uint32_t policyId = 1; // identifies the policy in saved filters
+    static constexpr uint32_t seed = 0;     // probe i uses seed + i
+
+    static constexpr unsigned int maxBatchProbes = 64;
+
+    std::size_t operator()(Key key, unsigned int probeIndex) const {
+        return murmur3_32(reinterpret_cast<const uint8_t*>(&key), sizeof(Key), seed + probeIndex);
+    }
+
+    // Probe hashes 0..numProbes-1 of several keys at once through the SIMD batch kernel
+    // out[key * numProbes + i] == (*this)(keys[key], i); numProbes must not exceed maxBatchProbes
+    void hash_batch(std::span<const Key> keys, unsigned int numProbes, uint32_t* out) const {
+        std::array<uint32_t, maxBatchProbes> seeds;
+        for (unsigned int probeIndex = 0; probeIndex < numProbes; probeIndex++) {
+            seeds[probeIndex] = seed + probeIndex;
+        }
+        murmur3_32_batch(reinterpret_cast<const uint8_t*>(keys.data()), sizeof(Key), keys.size(),
+            seeds.data(), numProbes, out);
+    }
+};
+
+// A hash wrapper that runs one 128-bit MurmurHash pass per key
+// and lets the filter derive every probe from the two halves
+template <typename Key>
+struct BloomDoubleHash {
+    static constexpr uint32_t policyId = 2;
+    static constexpr uint32_t seed = 0;
+
+    Hash128 operator()(const Key& key) const {
+        Hash128 hash = murmur3_x64_128(reinterpret_cast<const uint8_t*>(&key), sizeof(Key), seed);
+        hash.h2 |= 1; // an odd step never collapses all probes onto one position
+        return hash;
+    }
+};
+
+// Hashes the characters of a string, not the std::string object (which holds a pointer)
+// Accepts std::string, std::string_view and string literals alike
+struct BloomStringHash {
+    static constexpr uint32_t policyId = 3;
+    static constexpr uint32_t seed = 0;
+
+    Hash128 operator()(std::string_view key) const {
+        Hash128 hash = murmur3_x64_128(reinterpret_cast<const uint8_t*>(key.data()), key.size(), seed);
+        hash.h2 |= 1;
+        return hash;
+    }
+};
+
+// A k-mer of up to 32 bases packed two bits per base (A=0, C=1, G=2, T=3), first base highest
+// The length is not stored: all k-mers kept in one filter must have the same k
+struct PackedKmer {
+    uint64_t bits;
+
+    friend bool operator==(PackedKmer, PackedKmer) = default;
+};
+
+// Hashes a packed k-mer with two rounds of the 64-bit Murmur3 finalizer instead of a full pass
+// The packed value already fits one register, so there are no bytes to stream through
+struct BloomKmerHash {
+    static constexpr uint32_t policyId = 4;
+    static constexpr uint32_t seed = 0;
+
+    Hash128 operator()(PackedKmer key) const {
+        uint64_t h1 = fmix64(key.bits ^ (uint64_t{seed} << 32 | 0x9e3779b9ULL));
+        uint64_t h2 = fmix64(h1 ^ 0xc2b2ae3d27d4eb4fULL);
+        return Hash128{h1, h2 | 1};
+    }
+};
+
+// Hashes the object bytes of a trivially copyable key (e.g. a struct of integers) in one 128-bit pass
+// Padding bytes would make equal keys hash differently, so such types are rejected
+template <typename Key>
+struct BloomBytesHash {
+    static_assert(std::is_trivially_copyable_v<Key>, "BloomBytesHash needs a trivially copyable key");
+    static_assert(std::has_unique_object_representations_v<Key>,
+        "BloomBytesHash cannot hash a key with padding bytes; supply a custom hashing policy");
+
+    static constexpr uint32_t policyId = 5;
+    static constexpr uint32_t seed = 0;
+
+    Hash128 operator()(const Key& key) const {
+        Hash128 hash = murmur3_x64_128(reinterpret_cast<const uint8_t*>(&key), sizeof(Key), seed);
+        hash.h2 |= 1;
+        return hash;
+    }
+};
+
+// Compile-time choice of the hashing policy for a key type (see the table at the top of the file)
+// Specialise for your own key types to change the default of every filter
+template <typename Key>
+struct BloomHashTraits {
+    using type = std::conditional_t<std::is_arithmetic_v<Key> || std::is_enum_v<Key>,
+        BloomHash<Key>, BloomBytesHash<Key>>;
+};
+
+template <>
+struct BloomHashTraits<std::string> {
+    using type = BloomStringHash;
+};
+
+template <>
+struct BloomHashTraits<std::string_view> {
+    using type = BloomStringHash;
+};
+
+template <>
+struct BloomHashTraits<PackedKmer> {
+    using type = BloomKmerHash;
+};
+
+template <typename Key>
+using DefaultBloomHash = typename BloomHashTraits<Key>::type;
+
+// True for policies that hash a key once and return both 64-bit halves
+template <typename HashFunction, typename Key>
+concept DoubleHashPolicy = requires(const HashFunction& hasher, const Key& key) {
+    { hasher(key) } -> std::same_as<Hash128>;
+};
+
+// True for seeded policies that can hash a whole group of keys in one call (BloomHash)
+template <typename HashFunction, typename Key>
+concept BatchHashPolicy = requires(const HashFunction& hasher, std::span<const Key> keys, uint32_t* out) {
+    { HashFunction::maxBatchProbes } -> std::convertible_to<unsigned int>;
+    hasher.hash_batch(keys, 1u, out);
+};
+
+// Maps a 64-bit hash uniformly onto [0, range) using the high half of a 64x64-bit product
+// (Lemire's multiply-shift reduction), which is much cheaper than a modulo
+inline uint64_t reduce_range(uint64_t hash, uint64_t range) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128 = unsigned __int128;
+    return static_cast<uint64_t>((static_cast<uint128>(hash) * range) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return __umulh(hash, range);
+#else
+    // Portable high half of the product from 32-bit pieces
+    uint64_t hashLow = hash & 0xffffffffULL, hashHigh = hash >> 32;
+    uint64_t rangeLow = range & 0xffffffffULL, rangeHigh = range >> 32;
+    uint64_t lowLow = hashLow * rangeLow;
+    uint64_t highLow = hashHigh * rangeLow;
+    uint64_t lowHigh = hashLow * rangeHigh;
+    uint64_t middle = (lowLow >> 32) + (highLow & 0xffffffffULL) + lowHigh;
+    return hashHigh * rangeHigh + (highLow >> 32) + (middle >> 32);
+#endif
+}
+
+// Hints the CPU to start loading the cache line holding `address` (no-op where unsupported)
+inline void bloom_prefetch_read([[maybe_unused]] const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#endif
+}
+
+// Same as bloom_prefetch_read, but announces that the line is about to be written
+inline void bloom_prefetch_write([[maybe_unused]] const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 1, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#endif
+}
+
+// Number of bits that gives false-positive rate `targetFalsePositiveRate` for `expectedElementCount` keys
+// m = -n * ln(p) / ln(2)^2, rounded up to whole 512-bit cache lines
+inline uint64_t bloom_optimal_num_bits(uint64_t expectedElementCount, double targetFalsePositiveRate) {
+    const double ln2 = std::log(2.0);
+    double bits = -static_cast<double>(expectedElementCount) * std::log(targetFalsePositiveRate) / (ln2 * ln2);
+    uint64_t roundedBits = static_cast<uint64_t>(std::ceil(bits));
+    return std::max<uint64_t>(512, (roundedBits + 511) / 512 * 512);
+}
+
+// Number of hash functions that minimises the false-positive rate: k = m/n * ln(2)
+inline unsigned int bloom_optimal_num_hash_functions(uint64_t numBits, uint64_t expectedElementCount) {
+    double k = static_cast<double>(numBits) / static_cast<double>(expectedElementCount) * std::log(2.0);
+    return std::max(1u, static_cast<unsigned int>(std::lround(k)));
+}
+
+// Expected false-positive rate after `insertedCount` keys: (1 - e^(-k*n/m))^k
+inline double bloom_false_positive_probability(uint64_t numBits, uint64_t insertedCount,
+    unsigned int numberOfHashFunctions) {
+    double k = numberOfHashFunctions;
+    double fractionOfBitsSet = 1.0 - std::exp(-k * static_cast<double>(insertedCount) / static_cast<double>(numBits));
+    return std::pow(fractionOfBitsSet, k);
+}
+
+// Word-level helpers for cardinality and set algebra over the bit arrays.
+// The loops are kept branch-free over contiguous words so compilers can vectorise them.
+
+// Number of set bits in words[0, wordCount)
+inline uint64_t bloom_count_bits(const uint64_t* words, std::size_t wordCount) {
+    uint64_t totalBitsSet = 0;
+    for (std::size_t wordIndex = 0; wordIndex < wordCount; wordIndex++) {
+        totalBitsSet += static_cast<uint64_t>(std::popcount(words[wordIndex]));
+    }
+    return totalBitsSet;
+}
+
+// Number of bits set in either array, i.e. popcount(a | b)
+inline uint64_t bloom_count_union_bits(const uint64_t* wordsA, const uint64_t* wordsB, std::size_t wordCount) {
+    uint64_t totalBitsSet = 0;
+    for (std::size_t wordIndex = 0; wordIndex < wordCount; wordIndex++) {
+        totalBitsSet += static_cast<uint64_t>(std::popcount(wordsA[wordIndex] | wordsB[wordIndex]));
+    }
+    return totalBitsSet;
+}
+
+// target |= source, word by word
+inline void bloom_merge_words(uint64_t* target, const uint64_t* source, std::size_t wordCount) {
+    for (std::size_t wordIndex = 0; wordIndex < wordCount; wordIndex++) {
+        target[wordIndex] |= source[wordIndex];
+    }
+}
+
+// target &= source, word by word
+inline void bloom_intersect_words(uint64_t* target, const uint64_t* source, std::size_t wordCount) {
+    for (std::size_t wordIndex = 0; wordIndex < wordCount; wordIndex++) {
+        target[wordIndex] &= source[wordIndex];
+    }
+}
+
+// Estimated number of keys behind `bitsSet` of `numBits` bits: -m/k * ln(1 - X/m)
+// (Swamidass & Baldi). Returns uint64_t(-1) when every bit is set and no estimate is possible.
+inline uint64_t bloom_estimate_cardinality(uint64_t bitsSet, uint64_t numBits, unsigned int numberOfHashFunctions) {
+    double fractionOfBitsSet = static_cast<double>(bitsSet) / static_cast<double>(numBits);
+
+    if (fractionOfBitsSet >= 1.0) {
+        return static_cast<uint64_t>(-1); // Bloom filter is saturated, can't estimate
+    }
+
+    double estimatedInsertedElements =
+        -static_cast<double>(numBits) / numberOfHashFunctions * std::log(1.0 - fractionOfBitsSet);
+
+    return static_cast<uint64_t>(estimatedInsertedElements);
+}
+
+// Estimated size of the intersection from the estimates of both sets and of their union:
+// |A and B| = |A| + |B| - |A or B|, clamped at zero. Saturated inputs give uint64_t(-1).
+inline uint64_t bloom_estimate_intersection(uint64_t sizeA, uint64_t sizeB, uint64_t unionSize) {
+    const uint64_t saturated = static_cast<uint64_t>(-1);
+    if (sizeA == saturated || sizeB == saturated || unionSize == saturated) {
+        return saturated;
+    }
+    return sizeA + sizeB > unionSize ? sizeA + sizeB - unionSize : 0;
+}
+
+// Heap array of 64-bit words whose first word starts on a cache line (64-byte aligned)
+// Zero-initialised; copies are deep
+class AlignedWordArray {
+public:
+    static constexpr std::size_t alignment = 64;
+
+    AlignedWordArray() = default;
+
+    explicit AlignedWordArray(std::size_t wordCount)
+        : words_(allocate(wordCount)), wordCount_(wordCount) {
+        std::fill(words_, words_ + wordCount_, uint64_t{0});
+    }
+
+    AlignedWordArray(const AlignedWordArray& other)
+        : words_(allocate(other.wordCount_)), wordCount_(other.wordCount_) {
+        std::copy(other.words_, other.words_ + wordCount_, words_);
+    }
+
+    AlignedWordArray(AlignedWordArray&& other) noexcept
+        : words_(other.words_), wordCount_(other.wordCount_) {
+        other.words_ = nullptr;
+        other.wordCount_ = 0;
+    }
+
+    AlignedWordArray& operator=(AlignedWordArray other) noexcept {
+        std::swap(words_, other.words_);
+        std::swap(wordCount_, other.wordCount_);
+        return *this;
+    }
+
+    ~AlignedWordArray() {
+        if (words_ != nullptr) {
+            ::operator delete[](words_, std::align_val_t{alignment});
+        }
+    }
+
+    uint64_t* data() { return words_; }
+    const uint64_t* data() const { return words_; }
+    std::size_t size() const { return wordCount_; }
+
+    uint64_t& operator[](std::size_t wordIndex) { return words_[wordIndex]; }
+    uint64_t operator[](std::size_t wordIndex) const { return words_[wordIndex]; }
+
+private:
+    static uint64_t* allocate(std::size_t wordCount) {
+        if (wordCount == 0) return nullptr;
+        return static_cast<uint64_t*>(::operator new[](wordCount * sizeof(uint64_t), std::align_val_t{alignment}));
+    }
+
+    uint64_t* words_ = nullptr;
+    std::size_t wordCount_ = 0;
+};
+
+// Produces the 64-bit hash behind probe i of one key.
+// Double-hash policies are evaluated once in the constructor; seeded policies are evaluated
+// lazily per probe, so a lookup that stops at the first unset bit skips the remaining hashes.
+template <typename Key, typename HashFunction>
+class BloomProbes {
+public:
+    BloomProbes(const HashFunction& hasher, const Key& element)
+        : hasher_(hasher), element_(element) {
+        if constexpr (DoubleHashPolicy<HashFunction, Key>) {
+            baseHash_ = hasher_(element_);
+        }
+    }
+
+    uint64_t operator()(unsigned int probeIndex) const {
+        if constexpr (DoubleHashPolicy<HashFunction, Key>) {
+            return baseHash_.h1 + probeIndex * baseHash_.h2;
+        }
+        else {
+            // Seeded hashes are 32 bits wide; move them into the high half for reduce_range
+            return static_cast<uint64_t>(hasher_(element_, probeIndex)) << 32;
+        }
+    }
+
+private:
+    const HashFunction& hasher_;
+    const Key& element_;
+    Hash128 baseHash_{};
+};
+
+// Calls consume(keyIndex, probeIndex, probe hash) for probes 0..numProbes-1 of every key in
+// `group`, key-major, with the same hashes BloomProbes would give. Batch-capable policies hash
+// the group through murmur3_32_batch; the others go through BloomProbes one key at a time.
+template <typename Key, typename HashFunction, typename Consume>
+void bloom_probe_group(const HashFunction& hasher, std::span<const Key> group, unsigned int numProbes,
+    Consume&& consume) {
+    if (numProbes == 0) {
+        return; // nothing to hash, and the chunking below would divide by zero
+    }
+    if constexpr (BatchHashPolicy<HashFunction, Key>) {
+        if (numProbes <= HashFunction::maxBatchProbes) {
+            constexpr std::size_t bufferSize = 16 * HashFunction::maxBatchProbes;
+            std::array<uint32_t, bufferSize> hashes;
+            std::size_t keysPerChunk = bufferSize / numProbes;
+
+            for (std::size_t chunkStart = 0; chunkStart < group.size(); chunkStart += keysPerChunk) {
+                std::size_t chunkSize = std::min(keysPerChunk, group.size() - chunkStart);
+                hasher.hash_batch(group.subspan(chunkStart, chunkSize), numProbes, hashes.data());
+                for (std::size_t keyIndex = 0; keyIndex < chunkSize; keyIndex++) {
+                    for (unsigned int probeIndex = 0; probeIndex < numProbes; probeIndex++) {
+                        // Same placement as BloomProbes: the 32-bit hash goes into the high half
+                        consume(chunkStart + keyIndex, probeIndex,
+                            static_cast<uint64_t>(hashes[keyIndex * numProbes + probeIndex]) << 32);
+                    }
+                }
+            }
+            return;
+        }
+    }
+
+    for (std::size_t keyIndex = 0; keyIndex < group.size(); keyIndex++) {
+        BloomProbes<Key, HashFunction> probes(hasher, group[keyIndex]);
+        for (unsigned int probeIndex = 0; probeIndex < numProbes; probeIndex++) {
+            consume(keyIndex, probeIndex, probes(probeIndex));
+        }
+    }
+}
+
+#endif  // BLOOM_COMMON_HPP
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_bloom_filter.hpp"
+
+// Insert and lookup throughput of one shared ConcurrentBloomFilter at 1..N threads.
+// usage: a4_bloom_concurrent_benchmark [max threads] [number of keys]
+
+namespace {
+
+using Key = uint64_t;
+constexpr unsigned int filterBits = 1u << 28; // 32 MiB, larger than the caches
+constexpr unsigned int numberOfHashFunctions = 7;
+using Filter = ConcurrentBloomFilter<Key, filterBits, BloomDoubleHash<Key>>;
+
+// Splits [0, count) into `threadCount` slices and runs work(begin, end) on each in its own thread
+// Returns the wall time until the last thread finished
+template <typename Work>
+double run_parallel(unsigned int threadCount, std::size_t count, Work work) {
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+        std::size_t begin = count * threadIndex / threadCount;
+        std::size_t end = count * (threadIndex + 1) / threadCount;
+        threads.emplace_back(work, begin, end);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, const char* argv[]) {
+    unsigned int maxThreads = argc > 1 ? static_cast<unsigned int>(std::stoul(argv[1]))
+                                       : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t keyCount = argc > 2 ? std::stoul(argv[2]) : 8'000'000;
+
+    std::mt19937_64 generator(7);
+    std::vector<Key> keys(keyCount);
+    for (Key& key : keys) key = generator();
+
+    // 1, 2, 4, ... and finally maxThreads itself
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    std::cout << "million keys per second, " << keyCount << " keys, k = " << numberOfHashFunctions << '\n';
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "insert" << std::setw(10) << "speedup"
+        << std::setw(12) << "contains" << std::setw(10) << "speedup" << '\n';
+
+    double baseInsertRate = 0.0;
+    double baseQueryRate = 0.0;
+
+    for (unsigned int threadCount : threadCounts) {
+        auto filter = std::make_unique<Filter>(numberOfHashFunctions);
+        std::atomic<std::size_t> newlyInserted{0};
+        std::atomic<std::size_t> found{0};
+
+        double insertSeconds = run_parallel(threadCount, keyCount, [&](std::size_t begin, std::size_t end) {
+            std::size_t localNew = 0;
+            for (std::size_t i = begin; i < end; i++) {
+                if (filter->insert(keys[i])) localNew++;
+            }
+            newlyInserted += localNew;
+        });
+
+        double querySeconds = run_parallel(threadCount, keyCount, [&](std::size_t begin, std::size_t end) {
+            std::size_t localFound = 0;
+            for (std::size_t i = begin; i < end; i++) {
+                if (filter->contains(keys[i])) localFound++;
+            }
+            found += localFound;
+        });
+
+        // Every inserted key must be found, and no key can be reported new more than once
+        if (found != keyCount || newlyInserted > keyCount) {
+            std::cerr << "Inconsistent result at " << threadCount << " threads" << std::endl;
+            return 1;
+        }
+
+        double insertRate = static_cast<double>(keyCount) / insertSeconds / 1e6;
+        double queryRate = static_cast<double>(keyCount) / querySeconds / 1e6;
+        if (threadCount == 1) {
+            baseInsertRate = insertRate;
+            baseQueryRate = queryRate;
+        }
+
+        std::cout << std::setw(8) << threadCount << std::fixed << std::setprecision(1)
+            << std::setw(12) << insertRate << std::setw(9) << insertRate / baseInsertRate << 'x'
+            << std::setw(12) << queryRate << std::setw(9) << queryRate / baseQueryRate << 'x' << '\n';
+    }
+
+    return 0;
+}
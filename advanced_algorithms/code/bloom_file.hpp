@@ -0,0 +1,202 @@
+#ifndef BLOOM_FILE_HPP
+#define BLOOM_FILE_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "bloom_common.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// On-disk format of the Bloom filter family, in the byte order of the host that wrote it:
+//   bytes  0..63   BloomFileHeader
+//   bytes 64..     the raw 64-bit words of the filter
+// The words start 64 bytes into the file, so a page-aligned mapping keeps them cache-line aligned.
+// Mapping cannot swap bytes, so a file only opens on hosts of the writer's byte order; the
+// header's byteOrderMark tells the two apart.
+
+// Bit layouts a file can hold
+enum class BloomLayout : uint32_t {
+    plain = 0,   // BloomFilter / RuntimeBloomFilter: probe i sets bit reduce_range(probe, numBits)
+    blocked = 1  // BlockedBloomFilter: all probes of a key inside one 512-bit block
+};
+
+struct BloomFileHeader {
+    static constexpr char expectedMagic[8] = {'B', 'L', 'O', 'O', 'M', 'F', 'L', 'T'};
+    static constexpr uint32_t currentVersion = 1;
+    static constexpr uint32_t expectedByteOrderMark = 0x01020304; // reads as 0x04030201 if swapped
+
+    char magic[8];
+    uint32_t version;
+    uint32_t layout;                // BloomLayout
+    uint32_t hashPolicy;            // HashFunction::policyId
+    uint32_t hashSeed;              // HashFunction::seed
+    uint32_t numberOfHashFunctions;
+    uint32_t keySize;               // sizeof(Key) of the writer
+    uint64_t numBits;               // number of addressable bits (whole blocks for the blocked layout)
+    uint64_t wordCount;             // number of 64-bit words following the header
+    uint32_t byteOrderMark;         // expectedByteOrderMark in the writer's byte order
+    uint8_t reserved[12];
+};
+
+static_assert(sizeof(BloomFileHeader) == 64, "BloomFileHeader must stay 64 bytes");
+
+// Identifies a hashing policy inside a file, so a filter is never read back with a different hash
+// Policies opt in through static policyId / seed members
+template <typename HashFunction>
+concept PersistableHashPolicy = requires {
+    { HashFunction::policyId } -> std::convertible_to<uint32_t>;
+    { HashFunction::seed } -> std::convertible_to<uint32_t>;
+};
+
+// Builds the header describing a filter of the given shape
+template <typename Key, PersistableHashPolicy HashFunction>
+BloomFileHeader make_bloom_file_header(BloomLayout layout, uint64_t numBits,
+    unsigned int numberOfHashFunctions, uint64_t wordCount) {
+    BloomFileHeader header{};
+    std::memcpy(header.magic, BloomFileHeader::expectedMagic, sizeof(header.magic));
+    header.version = BloomFileHeader::currentVersion;
+    header.layout = static_cast<uint32_t>(layout);
+    header.hashPolicy = HashFunction::policyId;
+    header.hashSeed = HashFunction::seed;
+    header.numberOfHashFunctions = numberOfHashFunctions;
+    header.keySize = sizeof(Key);
+    header.numBits = numBits;
+    header.wordCount = wordCount;
+    header.byteOrderMark = BloomFileHeader::expectedByteOrderMark;
+    return header;
+}
+
+// Writes header and words to `path`, replacing any existing file
+// Throws std::runtime_error if the file cannot be written
+inline void write_bloom_file(const std::string& path, const BloomFileHeader& header,
+    const void* words, std::size_t byteCount) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("cannot open " + path + " for writing");
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(static_cast<const char*>(words), static_cast<std::streamsize>(byteCount));
+    if (!file) {
+        throw std::runtime_error("failed to write " + path);
+    }
+}
+
+// Read-only memory mapping of a whole file; unmapped in the destructor
+// Several processes mapping the same file share one page-cache copy
+class MappedFile {
+public:
+    // Maps `path` read-only. Throws std::runtime_error on failure
+    explicit MappedFile(const std::string& path) {
+#if defined(_WIN32)
+        fileHandle_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle_ == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle_, &fileSize) || fileSize.QuadPart == 0) {
+            CloseHandle(fileHandle_);
+            throw std::runtime_error("cannot map empty file " + path);
+        }
+        size_ = static_cast<std::size_t>(fileSize.QuadPart);
+        mappingHandle_ = CreateFileMappingA(fileHandle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle_ == nullptr) {
+            CloseHandle(fileHandle_);
+            throw std::runtime_error("cannot map " + path);
+        }
+        data_ = MapViewOfFile(mappingHandle_, FILE_MAP_READ, 0, 0, 0);
+        if (data_ == nullptr) {
+            CloseHandle(mappingHandle_);
+            CloseHandle(fileHandle_);
+            throw std::runtime_error("cannot map " + path);
+        }
+#else
+        int fileDescriptor = ::open(path.c_str(), O_RDONLY);
+        if (fileDescriptor < 0) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        struct stat fileStatus;
+        if (::fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0) {
+            ::close(fileDescriptor);
+            throw std::runtime_error("cannot map empty file " + path);
+        }
+        size_ = static_cast<std::size_t>(fileStatus.st_size);
+        void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+        ::close(fileDescriptor); // the mapping keeps the file alive
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("cannot map " + path);
+        }
+        data_ = mapping;
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : data_(other.data_), size_(other.size_)
+#if defined(_WIN32)
+        , fileHandle_(other.fileHandle_), mappingHandle_(other.mappingHandle_)
+#endif
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            data_ = other.data_;
+            size_ = other.size_;
+#if defined(_WIN32)
+            fileHandle_ = other.fileHandle_;
+            mappingHandle_ = other.mappingHandle_;
+#endif
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~MappedFile() { unmap(); }
+
+    const std::byte* data() const { return static_cast<const std::byte*>(data_); }
+    std::size_t size() const { return size_; }
+
+private:
+    void unmap() {
+        if (data_ == nullptr) return;
+#if defined(_WIN32)
+        UnmapViewOfFile(data_);
+        CloseHandle(mappingHandle_);
+        CloseHandle(fileHandle_);
+#else
+        ::munmap(data_, size_);
+#endif
+        data_ = nullptr;
+    }
+
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+#if defined(_WIN32)
+    HANDLE fileHandle_ = INVALID_HANDLE_VALUE;
+    HANDLE mappingHandle_ = nullptr;
+#endif
+};
+
+#endif  // BLOOM_FILE_HPP
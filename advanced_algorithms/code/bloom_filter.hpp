@@ -1,38 +1,39 @@
 ﻿#ifndef BLOOM_FILTER_HPP
 #define BLOOM_FILTER_HPP
 
-#include <bitset>
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <cmath>
 #include <cstdint>
 #include <initializer_list>
 #include <iterator>
-#include "murmurhash.hpp"
-
-// A hash wrapper that applies MurmurHash using a given seed
-template <typename Key>
-struct BloomHash {
-    std::size_t operator()(Key key, unsigned int seed) const {
-        return murmur3_32(reinterpret_cast<const uint8_t*>(&key), sizeof(Key), seed);
-    }
-};
+#include <span>
+#include <vector>
+#include <string>
+#include "bloom_common.hpp"
+#include "bloom_file.hpp"
 
 // BloomFilter class template
 // Key: type of elements stored (e.g., int, string hashable type)
 // numBits: size of the bit array
-// HashFunction: hashing strategy (defaults to BloomHash)
-template <typename Key, unsigned int numBits, typename HashFunction = BloomHash<Key>>
+// HashFunction: hashing strategy (defaults to DefaultBloomHash, see bloom_common.hpp; BloomDoubleHash hashes each key only once)
+template <typename Key, unsigned int numBits, typename HashFunction = DefaultBloomHash<Key>>
 class BloomFilter {
 public:
+    static constexpr std::size_t numWords = (numBits + 63) / 64;
+    static constexpr std::size_t batchGroupSize = 16; // keys hashed and prefetched together
+
     // Constructor: Initializes Bloom filter with a given number of hash functions
     explicit BloomFilter(unsigned int numberOfHashFunctions)
         : numberOfHashFunctions_(numberOfHashFunctions) {
-        bitStorage_.reset(); // clear all bits to 0
+        bitStorage_.fill(0); // clear all bits to 0
     }
 
     // Constructor that takes an initializer list (e.g., {1, 2, 3}) and inserts keys into the filter
     BloomFilter(std::initializer_list<Key> initialKeys, unsigned int numberOfHashFunctions)
         : numberOfHashFunctions_(numberOfHashFunctions) {
-        bitStorage_.reset();
+        bitStorage_.fill(0);
         for (const Key& element : initialKeys) {
             insert(element);
         }
@@ -42,7 +43,7 @@ public:
     template <typename Iterator>
     BloomFilter(Iterator iteratorBegin, Iterator iteratorEnd, unsigned int numberOfHashFunctions)
         : numberOfHashFunctions_(numberOfHashFunctions) {
-        bitStorage_.reset();
+        bitStorage_.fill(0);
         for (Iterator current = iteratorBegin; current != iteratorEnd; ++current) {
             insert(*current);
         }
@@ -51,14 +52,15 @@ public:
     // Inserts a key into the Bloom filter
     // Returns true if at least one new bit was set (i.e., changed from 0 to 1)
     bool insert(const Key& element) {
+        BloomProbes<Key, HashFunction> probes(hasher_, element);
         bool atLeastOneBitNewlySet = false;
 
         for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
-            std::size_t bitPosition = hasher_(element, hashIndex) % numBits;
-            if (!bitStorage_.test(bitPosition)) {
+            std::size_t bitPosition = reduce_range(probes(hashIndex), numBits);
+            if (!test_bit(bitPosition)) {
                 atLeastOneBitNewlySet = true; // A new bit is set, which was previously 0
             }
-            bitStorage_.set(bitPosition); // Set bit to 1
+            set_bit(bitPosition); // Set bit to 1
         }
 
         return atLeastOneBitNewlySet; // true if any new bit was changed from 0 to 1
@@ -67,27 +69,84 @@ public:
     // Checks if a key is *possibly* in the filter
     // Returns false if definitely not present, true if possibly present (could be a false positive)
     bool contains(const Key& element) const {
+        BloomProbes<Key, HashFunction> probes(hasher_, element);
+
         for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
-            std::size_t bitPosition = hasher_(element, hashIndex) % numBits;
-            if (!bitStorage_.test(bitPosition)) {
+            std::size_t bitPosition = reduce_range(probes(hashIndex), numBits);
+            if (!test_bit(bitPosition)) {
                 return false; // If any bit is 0, the key was not inserted
             }
         }
         return true; // possibly in the set (could be a false positive)
     }
 
-    // Calculate false positive rate
+    // Inserts every key of the span
+    // Keys are hashed a group at a time and all probe words of the group are prefetched
+    // before any of them is written, so the cache misses of different keys overlap
+    // Returns the number of keys that set at least one new bit
+    std::size_t insert_batch(std::span<const Key> elements) {
+        std::vector<std::size_t> bitPositions(batchGroupSize * numberOfHashFunctions_);
+        std::size_t newlyInsertedCount = 0;
+
+        for (std::size_t groupStart = 0; groupStart < elements.size(); groupStart += batchGroupSize) {
+            std::size_t groupSize = std::min(batchGroupSize, elements.size() - groupStart);
+            hash_group(elements.subspan(groupStart, groupSize), bitPositions);
+
+            for (std::size_t position = 0; position < groupSize * numberOfHashFunctions_; position++) {
+                bloom_prefetch_write(&bitStorage_[bitPositions[position] / 64]);
+            }
+
+            for (std::size_t keyIndex = 0; keyIndex < groupSize; keyIndex++) {
+                bool atLeastOneBitNewlySet = false;
+                for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
+                    std::size_t bitPosition = bitPositions[keyIndex * numberOfHashFunctions_ + hashIndex];
+                    if (!test_bit(bitPosition)) {
+                        atLeastOneBitNewlySet = true;
+                    }
+                    set_bit(bitPosition);
+                }
+                if (atLeastOneBitNewlySet) {
+                    newlyInsertedCount++;
+                }
+            }
+        }
+
+        return newlyInsertedCount;
+    }
+
+    // Looks up every key of the span; results[i] receives contains(elements[i])
+    // Uses the same hash-then-prefetch grouping as insert_batch
+    void contains_batch(std::span<const Key> elements, std::span<bool> results) const {
+        assert(results.size() >= elements.size());
+        std::vector<std::size_t> bitPositions(batchGroupSize * numberOfHashFunctions_);
+
+        for (std::size_t groupStart = 0; groupStart < elements.size(); groupStart += batchGroupSize) {
+            std::size_t groupSize = std::min(batchGroupSize, elements.size() - groupStart);
+            hash_group(elements.subspan(groupStart, groupSize), bitPositions);
+
+            for (std::size_t position = 0; position < groupSize * numberOfHashFunctions_; position++) {
+                bloom_prefetch_read(&bitStorage_[bitPositions[position] / 64]);
+            }
+
+            for (std::size_t keyIndex = 0; keyIndex < groupSize; keyIndex++) {
+                bool possiblyPresent = true;
+                for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_ && possiblyPresent; hashIndex++) {
+                    possiblyPresent = test_bit(bitPositions[keyIndex * numberOfHashFunctions_ + hashIndex]);
+                }
+                results[groupStart + keyIndex] = possiblyPresent;
+            }
+        }
+    }
+
+    // Calculate false positive rate over a set of keys known not to be in the filter
+    // (the positives are accepted for interface compatibility; they cannot produce false positives)
     template <typename Iterator>
     double false_positive_rate(
-        Iterator knownPositivesBegin, Iterator knownPositivesEnd,
+        Iterator /*knownPositivesBegin*/, Iterator /*knownPositivesEnd*/,
         Iterator knownNegativesBegin, Iterator knownNegativesEnd) const {
 
-        unsigned int falsePositiveCount = 0;
-        unsigned int totalNegativeSamples = 0;
-
-        for (Iterator it = knownPositivesBegin; it != knownPositivesEnd; ++it) {
-            contains(*it);
-        }
+        uint64_t falsePositiveCount = 0;
+        uint64_t totalNegativeSamples = 0;
 
         for (Iterator it = knownNegativesBegin; it != knownNegativesEnd; ++it) {
             totalNegativeSamples++;
@@ -98,7 +157,7 @@ public:
 
         if (totalNegativeSamples == 0) return 0.0; // Avoid division by zero
 
-        return static_cast<double>(falsePositiveCount) / totalNegativeSamples;
+        return static_cast<double>(falsePositiveCount) / static_cast<double>(totalNegativeSamples);
     }
 
     // Compares space used by the filter vs. optimal theoretical minimum
@@ -110,30 +169,69 @@ public:
 
     // Estimates how many elements have been inserted, based on number of set bits
     uint64_t approx_size() const {
-        int totalBitsSet = 0;
+        return bloom_estimate_cardinality(count_set_bits(), numBits, numberOfHashFunctions_);
+    }
 
-        for (unsigned int i = 0; i < numBits; i++) {
-            if (bitStorage_.test(i)) {
-                totalBitsSet++;
-            }
-        }
+    // Number of bits set to 1, counted a word at a time
+    uint64_t count_set_bits() const {
+        return bloom_count_bits(bitStorage_.data(), numWords);
+    }
 
-        double fractionOfBitsSet = static_cast<double>(totalBitsSet) / numBits;
+    // Adds every key of `other` to this filter (bitwise OR of the bit arrays)
+    // Afterwards contains() answers as if all keys of both filters had been inserted here.
+    // Filters of one type share their shape; both must use the same number of hash functions
+    void merge(const BloomFilter& other) {
+        assert(numberOfHashFunctions_ == other.numberOfHashFunctions_);
+        bloom_merge_words(bitStorage_.data(), other.bitStorage_.data(), numWords);
+    }
 
-        if (fractionOfBitsSet == 1.0) {
-            return static_cast<uint64_t>(-1); // Bloom filter is saturated, can't estimate
-        }
+    // Keeps only the bits set in both filters (bitwise AND)
+    // The result contains every key of the intersection, plus more false positives than a filter
+    // built from the intersection alone
+    void intersect(const BloomFilter& other) {
+        assert(numberOfHashFunctions_ == other.numberOfHashFunctions_);
+        bloom_intersect_words(bitStorage_.data(), other.bitStorage_.data(), numWords);
+    }
 
-        // Standard formula for estimating cardinality in Bloom filters
-        double estimatedInsertedElements =
-            -static_cast<double>(numBits) / numberOfHashFunctions_ *
-            std::log(1.0 - fractionOfBitsSet);
+    // Estimated number of distinct keys in the union of both filters, without modifying either
+    uint64_t approx_union_size(const BloomFilter& other) const {
+        assert(numberOfHashFunctions_ == other.numberOfHashFunctions_);
+        return bloom_estimate_cardinality(
+            bloom_count_union_bits(bitStorage_.data(), other.bitStorage_.data(), numWords),
+            numBits, numberOfHashFunctions_);
+    }
 
-        return static_cast<uint64_t>(estimatedInsertedElements);
+    // Estimated number of keys inserted into both filters
+    uint64_t approx_intersection_size(const BloomFilter& other) const {
+        return bloom_estimate_intersection(approx_size(), other.approx_size(), approx_union_size(other));
+    }
+
+    // Writes the filter to `path` in the versioned format of bloom_file.hpp,
+    // readable by MappedBloomFilter::open_mapped. Throws std::runtime_error on I/O failure
+    void save(const std::string& path) const requires PersistableHashPolicy<HashFunction> {
+        write_bloom_file(path,
+            make_bloom_file_header<Key, HashFunction>(BloomLayout::plain, numBits, numberOfHashFunctions_, numWords),
+            bitStorage_.data(), sizeof(bitStorage_));
     }
 
 private:
-    std::bitset<numBits> bitStorage_;           // Bit array representing the Bloom filter
+    bool test_bit(std::size_t bitPosition) const {
+        return (bitStorage_[bitPosition / 64] >> (bitPosition % 64)) & 1;
+    }
+
+    void set_bit(std::size_t bitPosition) {
+        bitStorage_[bitPosition / 64] |= uint64_t{1} << (bitPosition % 64);
+    }
+
+    // Computes all probe positions of a group of keys, key-major
+    void hash_group(std::span<const Key> group, std::vector<std::size_t>& bitPositions) const {
+        bloom_probe_group(hasher_, group, numberOfHashFunctions_,
+            [&](std::size_t keyIndex, unsigned int hashIndex, uint64_t probeHash) {
+                bitPositions[keyIndex * numberOfHashFunctions_ + hashIndex] = reduce_range(probeHash, numBits);
+            });
+    }
+
+    std::array<uint64_t, numWords> bitStorage_; // Bit array representing the Bloom filter, 64 bits per word
     unsigned int numberOfHashFunctions_;        // Number of hash functions used
     HashFunction hasher_;                       // hash function functor
 };
@@ -1,6 +1,414 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "blocked_bloom_filter.hpp"
 #include "bloom_filter.hpp"
+#include "counting_bloom_filter.hpp"
+#include "cuckoo_filter.hpp"
+#include "mapped_bloom_filter.hpp"
+#include "runtime_bloom_filter.hpp"
+#include "scalable_bloom_filter.hpp"
+
+// Behaviour checks for the Bloom filter family: one line per check, exit status 1 if any fails.
+// Keys are consecutive integers; the negatives used for false-positive rates start far above them.
+// Measured rates are compared against their bound plus three standard errors of the sample.
+
+namespace {
+
+constexpr uint64_t negativeKeysStart = uint64_t{1} << 40;
+
+bool report(const char* name, bool passed) {
+    std::cout << (passed ? "ok    " : "FAIL  ") << name << '\n';
+    return passed;
+}
+
+// Bound on a measured rate over `samples` draws: the expected rate plus three standard errors
+double with_sampling_margin(double rate, uint64_t samples) {
+    return rate + 3.0 * std::sqrt(rate * (1.0 - rate) / static_cast<double>(samples));
+}
+
+template <typename Filter>
+double measured_false_positive_rate(const Filter& filter, uint64_t samples) {
+    uint64_t falsePositiveCount = 0;
+    for (uint64_t key = negativeKeysStart; key < negativeKeysStart + samples; key++) {
+        if (filter.contains(key)) {
+            falsePositiveCount++;
+        }
+    }
+    return static_cast<double>(falsePositiveCount) / static_cast<double>(samples);
+}
+
+bool check_scalable_bloom_filter() {
+    bool passed = true;
+
+    // 20x the first layer's capacity: the chain must grow and still find every key
+    ScalableBloomFilter<uint64_t> filter(1000, 0.01);
+    const uint64_t keyCount = 20000;
+    for (uint64_t key = 0; key < keyCount; key++) {
+        filter.insert(key);
+    }
+    bool noFalseNegatives = true;
+    for (uint64_t key = 0; key < keyCount; key++) {
+        noFalseNegatives = noFalseNegatives && filter.contains(key);
+    }
+    passed &= report("scalable: grows past the first layer", filter.num_layers() > 1);
+    passed &= report("scalable: no false negatives", noFalseNegatives);
+
+    const uint64_t samples = 200000;
+    double rate = measured_false_positive_rate(filter, samples);
+    passed &= report("scalable: false-positive rate within the compounded bound",
+        filter.false_positive_bound() < 0.01 && rate <= with_sampling_margin(filter.false_positive_bound(), samples));
+
+    // Every key five times: duplicates must not use up capacity or be counted again
+    ScalableBloomFilter<uint64_t> repeated(1000, 0.01);
+    for (int round = 0; round < 5; round++) {
+        for (uint64_t key = 0; key < 1000; key++) {
+            repeated.insert(key);
+        }
+    }
+    uint64_t estimate = repeated.approx_size();
+    passed &= report("scalable: duplicates keep one layer", repeated.num_layers() == 1);
+    passed &= report("scalable: approx_size near the distinct count under duplicates",
+        estimate >= 950 && estimate <= 1050);
+    passed &= report("scalable: re-inserting a present key returns false", !repeated.insert(0));
+
+    return passed;
+}
+
+bool check_counting_bloom_filter() {
+    bool passed = true;
+    using Filter = CountingBloomFilter<uint64_t, 1 << 14>;
+    auto filter = std::make_unique<Filter>(4);
+    const uint64_t keyCount = 1000;
+
+    // Erasing from an empty filter must not wrap any counter around to 15
+    bool emptyEraseRejected = true;
+    for (uint64_t key = 0; key < keyCount; key++) {
+        emptyEraseRejected = emptyEraseRejected && !filter->erase(key);
+    }
+    passed &= report("counting: erase on an empty filter changes nothing",
+        emptyEraseRejected && filter->approx_size() == 0 && !filter->contains(0));
+
+    // insert / contains / erase round trip
+    for (uint64_t key = 0; key < keyCount; key++) {
+        filter->insert(key);
+    }
+    bool allPresent = true;
+    for (uint64_t key = 0; key < keyCount; key++) {
+        allPresent = allPresent && filter->contains(key);
+    }
+    passed &= report("counting: no false negatives after insert", allPresent);
+
+    // Keys that were never inserted: a rejected erase leaves every counter alone
+    for (uint64_t key = negativeKeysStart; key < negativeKeysStart + keyCount; key++) {
+        if (!filter->contains(key)) {
+            filter->erase(key);
+        }
+    }
+    allPresent = true;
+    for (uint64_t key = 0; key < keyCount; key++) {
+        allPresent = allPresent && filter->contains(key);
+    }
+    passed &= report("counting: erasing absent keys keeps every inserted key", allPresent);
+
+    bool allErased = true;
+    for (uint64_t key = 0; key < keyCount; key++) {
+        allErased = allErased && filter->erase(key);
+    }
+    passed &= report("counting: erase empties the filter again", allErased && filter->approx_size() == 0);
+
+    // A key inserted twice survives one erase
+    filter->insert(7);
+    filter->insert(7);
+    filter->erase(7);
+    bool survivesOneErase = filter->contains(7);
+    filter->erase(7);
+    passed &= report("counting: counts repeated inserts", survivesOneErase && !filter->contains(7));
+
+    // Saturated counters (15) never move again, so the key can no longer be erased
+    for (int repetition = 0; repetition < 40; repetition++) {
+        filter->insert(11);
+    }
+    for (int repetition = 0; repetition < 40; repetition++) {
+        filter->erase(11);
+    }
+    passed &= report("counting: saturated counters stay at 15", filter->contains(11));
+
+    // Batch forms agree with the scalar calls key by key
+    auto batchFilter = std::make_unique<Filter>(4);
+    std::vector<uint64_t> keys(keyCount);
+    std::iota(keys.begin(), keys.end(), uint64_t{0});
+    std::size_t inserted = batchFilter->insert_batch(keys);
+    std::unique_ptr<bool[]> results(new bool[keyCount]);
+    batchFilter->contains_batch(keys, std::span<bool>(results.get(), keyCount));
+    bool batchAgrees = inserted > 0;
+    for (uint64_t key = 0; key < keyCount; key++) {
+        batchAgrees = batchAgrees && results[key] && batchFilter->contains(key);
+    }
+    std::size_t erased = batchFilter->erase_batch(keys);
+    batchFilter->contains_batch(keys, std::span<bool>(results.get(), keyCount));
+    for (uint64_t key = 0; key < keyCount; key++) {
+        batchAgrees = batchAgrees && !results[key];
+    }
+    passed &= report("counting: insert_batch / contains_batch / erase_batch round trip",
+        batchAgrees && erased == keyCount && batchFilter->approx_size() == 0);
+
+    return passed;
+}
+
+bool check_cuckoo_filter() {
+    bool passed = true;
+    const uint64_t keyCount = 100000;
+    CuckooFilter<uint64_t> filter(keyCount);
+
+    // Sized for keyCount keys at targetLoadFactor: all of them must fit
+    uint64_t storedKeys = 0;
+    for (uint64_t key = 0; key < keyCount; key++) {
+        if (filter.insert(key)) {
+            storedKeys++;
+        }
+    }
+    passed &= report("cuckoo: every expected key fits at ~0.95 load",
+        storedKeys == keyCount && filter.failed_inserts() == 0 &&
+        filter.load_factor() >= 0.94 && filter.approx_size() == keyCount);
+
+    const uint64_t samples = 1000000;
+    double rate = measured_false_positive_rate(filter, samples);
+    passed &= report("cuckoo: false-positive rate below 0.1% at full load", rate <= 0.001);
+
+    // Keep inserting until the table is full: the first rejected insert may only come at capacity,
+    // after a displaced fingerprint was parked in the victim slot
+    uint64_t nextKey = keyCount;
+    double loadAtFirstFailure = 0.0;
+    std::vector<uint64_t> rejectedKeys;
+    while (nextKey < 2 * keyCount && rejectedKeys.empty()) {
+        double load = filter.load_factor();
+        if (!filter.insert(nextKey)) {
+            loadAtFirstFailure = load;
+            rejectedKeys.push_back(nextKey);
+        }
+        nextKey++;
+    }
+    passed &= report("cuckoo: inserts fail only at capacity",
+        !rejectedKeys.empty() && loadAtFirstFailure >= CuckooFilter<uint64_t>::targetLoadFactor);
+
+    // The victim slot holds the fingerprint the last kick chain could not place
+    bool noFalseNegatives = true;
+    for (uint64_t key = 0; key < nextKey; key++) {
+        if (key != rejectedKeys.front()) {
+            noFalseNegatives = noFalseNegatives && filter.contains(key);
+        }
+    }
+    passed &= report("cuckoo: no false negatives with a key in the victim slot", noFalseNegatives);
+
+    // Erasing frees slots: the victim moves back into the table and inserts succeed again
+    uint64_t storedBefore = filter.approx_size();
+    bool allErased = true;
+    for (uint64_t key = 0; key < 1000; key++) {
+        allErased = allErased && filter.erase(key);
+    }
+    noFalseNegatives = true;
+    for (uint64_t key = 1000; key < nextKey; key++) {
+        if (key != rejectedKeys.front()) {
+            noFalseNegatives = noFalseNegatives && filter.contains(key);
+        }
+    }
+    passed &= report("cuckoo: erase removes one copy per key",
+        allErased && filter.approx_size() == storedBefore - 1000 && noFalseNegatives);
+    passed &= report("cuckoo: inserts succeed again after erase", filter.insert(rejectedKeys.front()));
+
+    return passed;
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void write_file(const std::string& path, const std::string& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// Overwrites one header field of a saved filter
+template <typename Field>
+std::string with_header_field(std::string bytes, std::size_t offset, Field value) {
+    std::memcpy(bytes.data() + offset, &value, sizeof(value));
+    return bytes;
+}
+
+// True if open_mapped rejects the file with std::runtime_error
+template <typename Mapped>
+bool rejected(const std::string& path) {
+    try {
+        Mapped::open_mapped(path);
+        return false;
+    }
+    catch (const std::runtime_error&) {
+        return true;
+    }
+}
+
+// Saves `filter`, maps the file and compares contains() for the inserted keys and for negatives
+template <typename Filter>
+bool mapped_round_trip(const Filter& filter, uint64_t keyCount, const std::string& path, BloomLayout layout,
+    unsigned numberOfHashFunctions) {
+    filter.save(path);
+    auto mapped = MappedBloomFilter<uint64_t>::open_mapped(path);
+    bool agrees = mapped.layout() == layout && mapped.num_hash_functions() == numberOfHashFunctions;
+    for (uint64_t key = 0; key < keyCount; key++) {
+        agrees = agrees && mapped.contains(key);
+    }
+    for (uint64_t key = negativeKeysStart; key < negativeKeysStart + 10 * keyCount; key++) {
+        agrees = agrees && mapped.contains(key) == filter.contains(key);
+    }
+    return agrees;
+}
+
+bool check_mapped_bloom_filter() {
+    bool passed = true;
+    const std::string path = (std::filesystem::temp_directory_path() / "a4_bloom_filter_check.bin").string();
+    const uint64_t keyCount = 1000;
+
+    auto plain = std::make_unique<BloomFilter<uint64_t, 1 << 14>>(5);
+    auto blocked = std::make_unique<BlockedBloomFilter<uint64_t, 1 << 14>>(5);
+    RuntimeBloomFilter<uint64_t> runtime(keyCount, 0.01);
+    for (uint64_t key = 0; key < keyCount; key++) {
+        plain->insert(key);
+        blocked->insert(key);
+        runtime.insert(key);
+    }
+    passed &= report("mapped: BloomFilter save / open_mapped round trip",
+        mapped_round_trip(*plain, keyCount, path, BloomLayout::plain, 5));
+    passed &= report("mapped: BlockedBloomFilter save / open_mapped round trip",
+        mapped_round_trip(*blocked, keyCount, path, BloomLayout::blocked, 5));
+    passed &= report("mapped: RuntimeBloomFilter save / open_mapped round trip",
+        mapped_round_trip(runtime, keyCount, path, BloomLayout::plain, runtime.num_hash_functions()));
+
+    // Damaged or foreign files must be rejected, not read past their end
+    using Mapped = MappedBloomFilter<uint64_t>;
+    const std::string saved = read_file(path);
+    write_file(path, saved.substr(0, saved.size() - 8));
+    passed &= report("mapped: rejects a truncated file", rejected<Mapped>(path));
+    write_file(path, saved.substr(0, sizeof(BloomFileHeader) - 1));
+    passed &= report("mapped: rejects a file shorter than the header", rejected<Mapped>(path));
+    write_file(path, with_header_field(saved, offsetof(BloomFileHeader, version), uint32_t{99}));
+    passed &= report("mapped: rejects another format version", rejected<Mapped>(path));
+    write_file(path, with_header_field(saved, offsetof(BloomFileHeader, byteOrderMark), uint32_t{0x04030201}));
+    passed &= report("mapped: rejects another byte order", rejected<Mapped>(path));
+    // 2^61 + 1 words: wordCount * 8 wraps around to 8 bytes
+    write_file(path, with_header_field(saved, offsetof(BloomFileHeader, wordCount), (uint64_t{1} << 61) + 1));
+    passed &= report("mapped: rejects a word count whose byte size overflows", rejected<Mapped>(path));
+    write_file(path, saved);
+    passed &= report("mapped: rejects another hashing policy",
+        rejected<MappedBloomFilter<uint64_t, BloomDoubleHash<uint64_t>>>(path));
+
+    std::filesystem::remove(path);
+    return passed;
+}
+
+// Probes of two keys that compare equal, for the first `numProbes` probes
+template <typename Key, typename HashFunction = DefaultBloomHash<Key>>
+bool same_probes(const Key& left, const Key& right, unsigned int numProbes = 8) {
+    HashFunction hasher;
+    BloomProbes<Key, HashFunction> leftProbes(hasher, left);
+    BloomProbes<Key, HashFunction> rightProbes(hasher, right);
+    for (unsigned int probeIndex = 0; probeIndex < numProbes; probeIndex++) {
+        if (leftProbes(probeIndex) != rightProbes(probeIndex)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A key without padding bytes, hashed through BloomBytesHash
+struct GridCell {
+    uint32_t row;
+    uint32_t column;
+};
+
+// The content-hashing policies must hash what a key holds, not where it is stored
+bool check_content_hashing() {
+    bool passed = true;
+    const uint64_t keyCount = 2000;
+
+    // Longer than any small-string buffer, so both strings own separate heap buffers
+    const std::string text = "a key long enough to live on the heap, not inside the string object";
+    std::string copy;
+    for (char character : text) {
+        copy.push_back(character);
+    }
+    passed &= report("content hash: equal std::strings in different buffers give the same probes",
+        copy.data() != text.data() && same_probes(text, copy));
+    passed &= report("content hash: std::string and std::string_view give the same probes",
+        BloomStringHash{}(text).h1 == BloomStringHash{}(std::string_view(copy)).h1 &&
+        BloomStringHash{}(text).h2 == BloomStringHash{}(std::string_view(copy)).h2);
+    passed &= report("content hash: equal PackedKmers give the same probes",
+        same_probes(PackedKmer{0x1b2c3d}, PackedKmer{0x1b2c3d}));
+    passed &= report("content hash: equal byte-hashed keys give the same probes",
+        same_probes(GridCell{7, 11}, GridCell{7, 11}));
+
+    // Look every key up through a freshly built copy, never the object that was inserted
+    auto strings = std::make_unique<BloomFilter<std::string, 1 << 15>>(5);
+    auto kmers = std::make_unique<BloomFilter<PackedKmer, 1 << 15>>(5);
+    auto cells = std::make_unique<BloomFilter<GridCell, 1 << 15>>(5);
+    for (uint64_t key = 0; key < keyCount; key++) {
+        strings->insert("key number " + std::to_string(key));
+        kmers->insert(PackedKmer{key * 0x9e3779b97f4a7c15ULL});
+        cells->insert(GridCell{static_cast<uint32_t>(key / 64), static_cast<uint32_t>(key % 64)});
+    }
+    bool stringsFound = true;
+    bool kmersFound = true;
+    bool cellsFound = true;
+    for (uint64_t key = 0; key < keyCount; key++) {
+        stringsFound = stringsFound && strings->contains(std::string("key number ") + std::to_string(key));
+        kmersFound = kmersFound && kmers->contains(PackedKmer{key * 0x9e3779b97f4a7c15ULL});
+        cellsFound = cellsFound &&
+            cells->contains(GridCell{static_cast<uint32_t>(key / 64), static_cast<uint32_t>(key % 64)});
+    }
+    passed &= report("content hash: BloomFilter<std::string> has no false negatives", stringsFound);
+    passed &= report("content hash: BloomFilter<PackedKmer> has no false negatives", kmersFound);
+    passed &= report("content hash: BloomFilter of a byte-hashed struct has no false negatives", cellsFound);
+    return passed;
+}
+
+// With no hash functions every key is reported present; the batch forms must agree and not crash
+bool check_zero_hash_functions() {
+    auto filter = std::make_unique<BloomFilter<uint64_t, 1 << 12>>(0);
+    std::vector<uint64_t> keys(100);
+    std::iota(keys.begin(), keys.end(), uint64_t{0});
+    std::size_t newlyInserted = filter->insert_batch(keys);
+    std::unique_ptr<bool[]> results(new bool[keys.size()]);
+    filter->contains_batch(keys, std::span<bool>(results.get(), keys.size()));
+    bool allPresent = filter->contains(negativeKeysStart);
+    for (std::size_t keyIndex = 0; keyIndex < keys.size(); keyIndex++) {
+        allPresent = allPresent && results[keyIndex];
+    }
+    return report("k = 0: insert_batch / contains_batch agree with contains", newlyInserted == 0 && allPresent);
+}
+
+} // namespace
 
-int main(int argc, const char* argv[]) {
-  // you might test your bloom filter here
-  return 0;
+int main() {
+    bool passed = true;
+    passed &= check_scalable_bloom_filter();
+    passed &= check_counting_bloom_filter();
+    passed &= check_cuckoo_filter();
+    passed &= check_mapped_bloom_filter();
+    passed &= check_content_hashing();
+    passed &= check_zero_hash_functions();
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
 }
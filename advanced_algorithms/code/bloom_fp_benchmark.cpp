@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "runtime_bloom_filter.hpp"
+
+// Sizing data for Bloom filters: sweeps bits per key, number of hash functions and hashing policy,
+// and for every combination reports the measured vs. theoretical false-positive rate, the memory
+// actually used per key and the insert/query throughput at 1..N threads.
+// Inserts are sharded: every thread fills its own filter and the shards are merged at the end.
+// Queries run concurrently against the merged filter.
+// usage: a4_bloom_fp_benchmark [--format csv|json] [--keys N] [--queries N] [--threads N]
+
+namespace {
+
+using Key = uint64_t;
+
+struct Options {
+    bool json = false;
+    std::size_t keyCount = 1'000'000;
+    std::size_t queryCount = 1'000'000;
+    unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+};
+
+struct Result {
+    const char* policy;
+    unsigned int bitsPerKey;
+    unsigned int numberOfHashFunctions;
+    uint64_t numBits;
+    unsigned int threads;
+    double measuredFalsePositiveRate;
+    double theoreticalFalsePositiveRate;
+    double actualBitsPerKey;
+    double insertRate; // million keys per second
+    double queryRate;
+};
+
+// Splits [0, count) into `threadCount` slices and runs work(threadIndex, begin, end) on each in its own thread
+// Returns the wall time until the last thread finished
+template <typename Work>
+double run_parallel(unsigned int threadCount, std::size_t count, Work work) {
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+        std::size_t begin = count * threadIndex / threadCount;
+        std::size_t end = count * (threadIndex + 1) / threadCount;
+        threads.emplace_back(work, threadIndex, begin, end);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Builds a filter of the given shape from `keys` with `threadCount` shards, then measures
+// lookups of `negatives` (keys never inserted) with the same number of threads
+template <typename HashFunction>
+Result run_configuration(const char* policyName, unsigned int bitsPerKey, unsigned int numberOfHashFunctions,
+    unsigned int threadCount, const std::vector<Key>& keys, const std::vector<Key>& negatives) {
+
+    using Filter = RuntimeBloomFilter<Key, HashFunction>;
+    uint64_t numBits = static_cast<uint64_t>(keys.size()) * bitsPerKey;
+
+    std::vector<Filter> shards;
+    shards.reserve(threadCount);
+    for (unsigned int threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+        shards.push_back(Filter::with_shape(numBits, numberOfHashFunctions));
+    }
+
+    auto insertStart = std::chrono::steady_clock::now();
+    run_parallel(threadCount, keys.size(), [&](unsigned int threadIndex, std::size_t begin, std::size_t end) {
+        shards[threadIndex].insert_batch(std::span<const Key>(keys.data() + begin, end - begin));
+    });
+    for (unsigned int threadIndex = 1; threadIndex < threadCount; threadIndex++) {
+        shards[0].merge(shards[threadIndex]);
+    }
+    double insertSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - insertStart).count();
+    const Filter& filter = shards[0];
+
+    // A Bloom filter never forgets a key
+    std::unique_ptr<bool[]> found = std::make_unique<bool[]>(keys.size());
+    filter.contains_batch(keys, std::span<bool>(found.get(), keys.size()));
+    if (!std::all_of(found.get(), found.get() + keys.size(), [](bool present) { return present; })) {
+        std::cerr << "False negative with " << policyName << ", k = " << numberOfHashFunctions << std::endl;
+        std::exit(1);
+    }
+
+    std::atomic<std::size_t> falsePositives{0};
+    double querySeconds = run_parallel(threadCount, negatives.size(),
+        [&](unsigned int, std::size_t begin, std::size_t end) {
+            std::size_t sliceSize = end - begin;
+            std::unique_ptr<bool[]> results = std::make_unique<bool[]>(sliceSize);
+            filter.contains_batch(std::span<const Key>(negatives.data() + begin, sliceSize),
+                std::span<bool>(results.get(), sliceSize));
+            falsePositives += static_cast<std::size_t>(std::count(results.get(), results.get() + sliceSize, true));
+        });
+
+    Result result;
+    result.policy = policyName;
+    result.bitsPerKey = bitsPerKey;
+    result.numberOfHashFunctions = numberOfHashFunctions;
+    result.numBits = filter.num_bits();
+    result.threads = threadCount;
+    result.measuredFalsePositiveRate = static_cast<double>(falsePositives) / static_cast<double>(negatives.size());
+    result.theoreticalFalsePositiveRate =
+        bloom_false_positive_probability(filter.num_bits(), keys.size(), numberOfHashFunctions);
+    result.actualBitsPerKey = static_cast<double>(filter.memory_bytes()) * 8.0 / static_cast<double>(keys.size());
+    result.insertRate = static_cast<double>(keys.size()) / insertSeconds / 1e6;
+    result.queryRate = static_cast<double>(negatives.size()) / querySeconds / 1e6;
+    return result;
+}
+
+void print_csv_header() {
+    std::cout << "policy,bits_per_key,k,num_bits,threads,measured_fp,theoretical_fp,"
+        "actual_bits_per_key,insert_mkeys_per_s,query_mkeys_per_s\n";
+}
+
+void print_csv(const Result& result) {
+    std::cout << result.policy << ',' << result.bitsPerKey << ',' << result.numberOfHashFunctions << ','
+        << result.numBits << ',' << result.threads << ','
+        << std::scientific << std::setprecision(4)
+        << result.measuredFalsePositiveRate << ',' << result.theoreticalFalsePositiveRate << ','
+        << std::fixed << std::setprecision(3) << result.actualBitsPerKey << ','
+        << std::setprecision(2) << result.insertRate << ',' << result.queryRate << '\n';
+}
+
+void print_json(const Result& result, bool first) {
+    std::cout << (first ? "  " : ",\n  ")
+        << "{\"policy\": \"" << result.policy << "\", \"bits_per_key\": " << result.bitsPerKey
+        << ", \"k\": " << result.numberOfHashFunctions << ", \"num_bits\": " << result.numBits
+        << ", \"threads\": " << result.threads
+        << std::scientific << std::setprecision(4)
+        << ", \"measured_fp\": " << result.measuredFalsePositiveRate
+        << ", \"theoretical_fp\": " << result.theoreticalFalsePositiveRate
+        << std::fixed << std::setprecision(3)
+        << ", \"actual_bits_per_key\": " << result.actualBitsPerKey
+        << std::setprecision(2)
+        << ", \"insert_mkeys_per_s\": " << result.insertRate
+        << ", \"query_mkeys_per_s\": " << result.queryRate << '}';
+}
+
+[[noreturn]] void exit_with_usage() {
+    std::cerr << "usage: a4_bloom_fp_benchmark [--format csv|json] [--keys N] [--queries N] [--threads N]\n"
+        "  N is a positive whole number" << std::endl;
+    std::exit(1);
+}
+
+// Parses a positive count of at most `maxValue`; anything else (0, signs, trailing text) exits with the usage line
+std::size_t parse_count(const std::string& argument, const std::string& value, std::size_t maxValue) {
+    bool allDigits = !value.empty() &&
+        std::all_of(value.begin(), value.end(), [](char character) { return character >= '0' && character <= '9'; });
+    std::size_t count = 0;
+    try {
+        count = allDigits ? std::stoull(value) : 0;
+    }
+    catch (const std::out_of_range&) {
+        count = 0;
+    }
+    if (count == 0 || count > maxValue) {
+        std::cerr << "Invalid value for " << argument << ": " << value << std::endl;
+        exit_with_usage();
+    }
+    return count;
+}
+
+Options parse_options(int argc, const char* argv[]) {
+    Options options;
+    for (int argIndex = 1; argIndex < argc; argIndex++) {
+        std::string argument = argv[argIndex];
+        if (argIndex + 1 >= argc) {
+            std::cerr << "Missing value for " << argument << std::endl;
+            exit_with_usage();
+        }
+        std::string value = argv[++argIndex];
+        if (argument == "--format") {
+            if (value != "csv" && value != "json") {
+                std::cerr << "Invalid value for " << argument << ": " << value << std::endl;
+                exit_with_usage();
+            }
+            options.json = (value == "json");
+        }
+        else if (argument == "--keys") {
+            options.keyCount = parse_count(argument, value, std::numeric_limits<std::size_t>::max());
+        }
+        else if (argument == "--queries") {
+            options.queryCount = parse_count(argument, value, std::numeric_limits<std::size_t>::max());
+        }
+        else if (argument == "--threads") {
+            options.maxThreads = static_cast<unsigned int>(
+                parse_count(argument, value, std::numeric_limits<unsigned int>::max()));
+        }
+        else {
+            exit_with_usage();
+        }
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[]) {
+    Options options = parse_options(argc, argv);
+
+    // Random 64-bit keys; the negatives are drawn from the same generator and, with 2^64 values,
+    // collide with an inserted key with negligible probability
+    std::mt19937_64 generator(2024);
+    std::vector<Key> keys(options.keyCount);
+    for (Key& key : keys) key = generator();
+    std::vector<Key> negatives(options.queryCount);
+    for (Key& key : negatives) key = generator();
+
+    // 1, 2, 4, ... and finally maxThreads itself
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int threads = 1; threads < options.maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(options.maxThreads);
+
+    const unsigned int bitsPerKeySweep[] = {4, 6, 8, 10, 12, 16, 20};
+
+    if (options.json) std::cout << "[\n";
+    else print_csv_header();
+    bool first = true;
+
+    auto emit = [&](const Result& result) {
+        if (options.json) print_json(result, first);
+        else print_csv(result);
+        first = false;
+    };
+
+    for (unsigned int bitsPerKey : bitsPerKeySweep) {
+        // Around the optimum k = bits per key * ln 2
+        unsigned int optimalK = bloom_optimal_num_hash_functions(bitsPerKey, 1);
+        unsigned int lowestK = optimalK > 2 ? optimalK - 2 : 1;
+        for (unsigned int k = lowestK; k <= optimalK + 2; k++) {
+            for (unsigned int threadCount : threadCounts) {
+                emit(run_configuration<BloomHash<Key>>("seeded", bitsPerKey, k, threadCount, keys, negatives));
+                emit(run_configuration<BloomDoubleHash<Key>>("double", bitsPerKey, k, threadCount, keys, negatives));
+            }
+        }
+    }
+
+    if (options.json) std::cout << "\n]\n";
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+#ifndef CONCURRENT_BLOOM_FILTER_HPP
+#define CONCURRENT_BLOOM_FILTER_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include "bloom_common.hpp"
+
+// ConcurrentBloomFilter class template
+// Same probing as BloomFilter, but the bits live in 64-bit atomic words, so any number of
+// threads may insert and query one filter without external locking.
+// Inserts use a relaxed fetch_or; lookups are plain relaxed loads and never block.
+// Key: type of elements stored
+// numBits: size of the bit array
+// HashFunction: hashing strategy (defaults to DefaultBloomHash, see bloom_common.hpp)
+template <typename Key, unsigned int numBits, typename HashFunction = DefaultBloomHash<Key>>
+class ConcurrentBloomFilter {
+public:
+    static constexpr std::size_t numWords = (numBits + 63) / 64;
+
+    // Constructor: Initializes Bloom filter with a given number of hash functions
+    explicit ConcurrentBloomFilter(unsigned int numberOfHashFunctions)
+        : numberOfHashFunctions_(numberOfHashFunctions) {
+        for (std::atomic<uint64_t>& word : bitStorage_) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Constructor that takes an initializer list (e.g., {1, 2, 3}) and inserts keys into the filter
+    ConcurrentBloomFilter(std::initializer_list<Key> initialKeys, unsigned int numberOfHashFunctions)
+        : ConcurrentBloomFilter(numberOfHashFunctions) {
+        for (const Key& element : initialKeys) {
+            insert(element);
+        }
+    }
+
+    // Constructor that inserts keys using iterators from any container (e.g., vector, set)
+    template <typename Iterator>
+    ConcurrentBloomFilter(Iterator iteratorBegin, Iterator iteratorEnd, unsigned int numberOfHashFunctions)
+        : ConcurrentBloomFilter(numberOfHashFunctions) {
+        for (Iterator current = iteratorBegin; current != iteratorEnd; ++current) {
+            insert(*current);
+        }
+    }
+
+    // The atomic storage can neither be copied nor moved
+    ConcurrentBloomFilter(const ConcurrentBloomFilter&) = delete;
+    ConcurrentBloomFilter& operator=(const ConcurrentBloomFilter&) = delete;
+
+    // Inserts a key into the Bloom filter; safe to call from several threads at once
+    // Returns true if this call flipped at least one bit from 0 to 1. fetch_or reports the
+    // previous word atomically, so when threads race on the same bit exactly one of them sees it
+    // as newly set.
+    bool insert(const Key& element) {
+        BloomProbes<Key, HashFunction> probes(hasher_, element);
+        bool atLeastOneBitNewlySet = false;
+
+        for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
+            std::size_t bitPosition = reduce_range(probes(hashIndex), numBits);
+            std::atomic<uint64_t>& word = bitStorage_[bitPosition / 64];
+            uint64_t mask = uint64_t{1} << (bitPosition % 64);
+
+            // Skip the read-modify-write when the bit is already set: a plain load keeps
+            // the cache line shared between cores instead of bouncing it around
+            if (word.load(std::memory_order_relaxed) & mask) {
+                continue;
+            }
+            if ((word.fetch_or(mask, std::memory_order_relaxed) & mask) == 0) {
+                atLeastOneBitNewlySet = true;
+            }
+        }
+
+        return atLeastOneBitNewlySet;
+    }
+
+    // Checks if a key is *possibly* in the filter; lock-free
+    // A key whose insert() has completed (and is visible to this thread) is always found
+    bool contains(const Key& element) const {
+        BloomProbes<Key, HashFunction> probes(hasher_, element);
+
+        for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
+            std::size_t bitPosition = reduce_range(probes(hashIndex), numBits);
+            uint64_t word = bitStorage_[bitPosition / 64].load(std::memory_order_relaxed);
+            if ((word & (uint64_t{1} << (bitPosition % 64))) == 0) {
+                return false; // If any bit is 0, the key was not inserted
+            }
+        }
+        return true; // possibly in the set (could be a false positive)
+    }
+
+    // Calculate false positive rate over a set of keys known not to be in the filter
+    // (the positives are accepted for interface parity with BloomFilter)
+    template <typename Iterator>
+    double false_positive_rate(
+        Iterator /*knownPositivesBegin*/, Iterator /*knownPositivesEnd*/,
+        Iterator knownNegativesBegin, Iterator knownNegativesEnd) const {
+
+        uint64_t falsePositiveCount = 0;
+        uint64_t totalNegativeSamples = 0;
+
+        for (Iterator it = knownNegativesBegin; it != knownNegativesEnd; ++it) {
+            totalNegativeSamples++;
+            if (contains(*it)) {
+                falsePositiveCount++;
+            }
+        }
+
+        if (totalNegativeSamples == 0) return 0.0; // Avoid division by zero
+
+        return static_cast<double>(falsePositiveCount) / static_cast<double>(totalNegativeSamples);
+    }
+
+    // Compares space used by the filter vs. storing the keys themselves
+    double space_ratio(uint64_t expectedElementCount) const {
+        std::size_t actualBitMemory = sizeof(bitStorage_);
+        std::size_t optimalBitMemory = expectedElementCount * sizeof(Key);
+        return static_cast<double>(actualBitMemory) / static_cast<double>(optimalBitMemory);
+    }
+
+    // Estimates how many elements have been inserted, based on number of set bits
+    // (a snapshot: concurrent inserts may or may not be counted)
+    uint64_t approx_size() const {
+        uint64_t totalBitsSet = 0;
+
+        for (const std::atomic<uint64_t>& word : bitStorage_) {
+            totalBitsSet += static_cast<uint64_t>(std::popcount(word.load(std::memory_order_relaxed)));
+        }
+
+        return bloom_estimate_cardinality(totalBitsSet, numBits, numberOfHashFunctions_);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, numWords> bitStorage_; // Bit array, 64 bits per atomic word
+    unsigned int numberOfHashFunctions_;                      // Number of hash functions used
+    HashFunction hasher_;                                     // hash function functor
+};
+
+#endif  // CONCURRENT_BLOOM_FILTER_HPP
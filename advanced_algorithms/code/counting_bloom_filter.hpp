@@ -0,0 +1,256 @@
+#ifndef COUNTING_BLOOM_FILTER_HPP
+#define COUNTING_BLOOM_FILTER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <vector>
+#include "bloom_common.hpp"
+
+// CountingBloomFilter class template
+// A Bloom filter whose slots are 4-bit saturating counters instead of bits, so keys can be erased.
+// Sixteen counters are packed into each 64-bit word and all counters a key touches inside one word
+// are updated together with SWAR (SIMD within a register) arithmetic.
+// A counter that reaches 15 stays at 15 forever: erasing through it could otherwise
+// produce false negatives.
+// Key: type of elements stored
+// numCounters: number of 4-bit counters
+// HashFunction: hashing strategy (defaults to DefaultBloomHash, see bloom_common.hpp)
+template <typename Key, unsigned int numCounters, typename HashFunction = DefaultBloomHash<Key>>
+class CountingBloomFilter {
+public:
+    // Thrown when the filter is constructed with an unusable number of hash functions
+    class Invalid {};
+
+    static constexpr std::size_t countersPerWord = 16;
+    static constexpr std::size_t numWords = (numCounters + countersPerWord - 1) / countersPerWord;
+    static constexpr unsigned int maxHashFunctions = 32;
+    static constexpr std::size_t batchGroupSize = 16; // keys hashed and prefetched together
+
+    // Constructor: Initializes the filter with a given number of hash functions (1..32)
+    explicit CountingBloomFilter(unsigned int numberOfHashFunctions)
+        : numberOfHashFunctions_(numberOfHashFunctions) {
+        if (numberOfHashFunctions == 0 || numberOfHashFunctions > maxHashFunctions) {
+            throw Invalid{};
+        }
+        counterStorage_.fill(0);
+    }
+
+    // Constructor that takes an initializer list (e.g., {1, 2, 3}) and inserts keys into the filter
+    CountingBloomFilter(std::initializer_list<Key> initialKeys, unsigned int numberOfHashFunctions)
+        : CountingBloomFilter(numberOfHashFunctions) {
+        for (const Key& element : initialKeys) {
+            insert(element);
+        }
+    }
+
+    // Constructor that inserts keys using iterators from any container (e.g., vector, set)
+    template <typename Iterator>
+    CountingBloomFilter(Iterator iteratorBegin, Iterator iteratorEnd, unsigned int numberOfHashFunctions)
+        : CountingBloomFilter(numberOfHashFunctions) {
+        for (Iterator current = iteratorBegin; current != iteratorEnd; ++current) {
+            insert(*current);
+        }
+    }
+
+    // Inserts a key by incrementing its counters
+    // Returns true if at least one counter went from 0 to 1
+    bool insert(const Key& element) {
+        std::array<CounterGroup, maxHashFunctions> groups;
+        return increment(groups.data(), group_counters(element, groups.data()));
+    }
+
+    // Removes one occurrence of a key by decrementing its counters
+    // Returns false (and changes nothing) if the key is definitely not in the filter.
+    // Erasing a key that was never inserted may remove a different key.
+    bool erase(const Key& element) {
+        std::array<CounterGroup, maxHashFunctions> groups;
+        return decrement(groups.data(), group_counters(element, groups.data()));
+    }
+
+    // Checks if a key is *possibly* in the filter (all of its counters are nonzero)
+    bool contains(const Key& element) const {
+        std::array<CounterGroup, maxHashFunctions> groups;
+        return all_nonzero(groups.data(), group_counters(element, groups.data()));
+    }
+
+    // Inserts every key of the span, prefetching the counter words of a group of keys first
+    // Returns the number of keys that moved at least one counter from 0 to 1
+    std::size_t insert_batch(std::span<const Key> elements) {
+        std::size_t newlyInsertedCount = 0;
+        for_each_group(elements, true, [&](std::size_t, CounterGroup* groups, std::size_t groupCount) {
+            if (increment(groups, groupCount)) newlyInsertedCount++;
+        });
+        return newlyInsertedCount;
+    }
+
+    // Erases every key of the span; returns the number of keys that were actually erased
+    std::size_t erase_batch(std::span<const Key> elements) {
+        std::size_t erasedCount = 0;
+        for_each_group(elements, true, [&](std::size_t, CounterGroup* groups, std::size_t groupCount) {
+            if (decrement(groups, groupCount)) erasedCount++;
+        });
+        return erasedCount;
+    }
+
+    // Looks up every key of the span; results[i] receives contains(elements[i])
+    void contains_batch(std::span<const Key> elements, std::span<bool> results) const {
+        assert(results.size() >= elements.size());
+        for_each_group(elements, false, [&](std::size_t keyIndex, CounterGroup* groups, std::size_t groupCount) {
+            results[keyIndex] = all_nonzero(groups, groupCount);
+        });
+    }
+
+    // Calculate false positive rate over a set of keys known not to be in the filter
+    // (the positives are accepted for interface parity with BloomFilter)
+    template <typename Iterator>
+    double false_positive_rate(
+        Iterator /*knownPositivesBegin*/, Iterator /*knownPositivesEnd*/,
+        Iterator knownNegativesBegin, Iterator knownNegativesEnd) const {
+
+        uint64_t falsePositiveCount = 0;
+        uint64_t totalNegativeSamples = 0;
+
+        for (Iterator it = knownNegativesBegin; it != knownNegativesEnd; ++it) {
+            totalNegativeSamples++;
+            if (contains(*it)) {
+                falsePositiveCount++;
+            }
+        }
+
+        if (totalNegativeSamples == 0) return 0.0; // Avoid division by zero
+
+        return static_cast<double>(falsePositiveCount) / static_cast<double>(totalNegativeSamples);
+    }
+
+    // Compares space used by the filter vs. storing the keys themselves
+    double space_ratio(uint64_t expectedElementCount) const {
+        std::size_t actualBitMemory = sizeof(counterStorage_);
+        std::size_t optimalBitMemory = expectedElementCount * sizeof(Key);
+        return static_cast<double>(actualBitMemory) / static_cast<double>(optimalBitMemory);
+    }
+
+    // Estimates how many distinct elements are currently stored, based on the nonzero counters
+    uint64_t approx_size() const {
+        uint64_t nonzeroCounters = 0;
+        for (uint64_t word : counterStorage_) {
+            nonzeroCounters += static_cast<uint64_t>(std::popcount(nonzero_nibbles(word)));
+        }
+
+        return bloom_estimate_cardinality(nonzeroCounters, numCounters, numberOfHashFunctions_);
+    }
+
+private:
+    // The counters one key touches inside one word: 0x1 in each selected nibble
+    struct CounterGroup {
+        std::size_t wordIndex;
+        uint64_t nibbleMask;
+    };
+
+    static constexpr uint64_t lowNibbleBits = 0x1111111111111111ULL;
+
+    // 0x1 in every nibble of `word` that is nonzero
+    static uint64_t nonzero_nibbles(uint64_t word) {
+        return (word | (word >> 1) | (word >> 2) | (word >> 3)) & lowNibbleBits;
+    }
+
+    // 0x1 in every nibble of `word` that is saturated (equal to 15)
+    static uint64_t saturated_nibbles(uint64_t word) {
+        return word & (word >> 1) & (word >> 2) & (word >> 3) & lowNibbleBits;
+    }
+
+    // Collects the key's counters, merging counters that share a word
+    // Returns the number of groups written to `groups` (at most numberOfHashFunctions_)
+    std::size_t group_counters(const Key& element, CounterGroup* groups) const {
+        BloomProbes<Key, HashFunction> probes(hasher_, element);
+        std::size_t groupCount = 0;
+
+        for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
+            std::size_t counterIndex = reduce_range(probes(hashIndex), numCounters);
+            std::size_t wordIndex = counterIndex / countersPerWord;
+            uint64_t nibble = uint64_t{1} << (4 * (counterIndex % countersPerWord));
+
+            std::size_t group = 0;
+            while (group < groupCount && groups[group].wordIndex != wordIndex) group++;
+            if (group == groupCount) {
+                groups[groupCount++] = CounterGroup{wordIndex, 0};
+            }
+            groups[group].nibbleMask |= nibble;
+        }
+        return groupCount;
+    }
+
+    // Adds 1 to every selected counter that is not saturated; no nibble can carry into its neighbour
+    bool increment(const CounterGroup* groups, std::size_t groupCount) {
+        bool atLeastOneCounterNewlySet = false;
+        for (std::size_t group = 0; group < groupCount; group++) {
+            uint64_t& word = counterStorage_[groups[group].wordIndex];
+            uint64_t mask = groups[group].nibbleMask;
+            if ((mask & ~nonzero_nibbles(word)) != 0) {
+                atLeastOneCounterNewlySet = true;
+            }
+            word += mask & ~saturated_nibbles(word);
+        }
+        return atLeastOneCounterNewlySet;
+    }
+
+    // Subtracts 1 from every selected counter that is not saturated, but only if all of them are
+    // nonzero; no nibble can borrow from its neighbour
+    bool decrement(const CounterGroup* groups, std::size_t groupCount) {
+        if (!all_nonzero(groups, groupCount)) {
+            return false;
+        }
+        for (std::size_t group = 0; group < groupCount; group++) {
+            uint64_t& word = counterStorage_[groups[group].wordIndex];
+            word -= groups[group].nibbleMask & ~saturated_nibbles(word);
+        }
+        return true;
+    }
+
+    bool all_nonzero(const CounterGroup* groups, std::size_t groupCount) const {
+        for (std::size_t group = 0; group < groupCount; group++) {
+            uint64_t mask = groups[group].nibbleMask;
+            if ((nonzero_nibbles(counterStorage_[groups[group].wordIndex]) & mask) != mask) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Groups the counters of batchGroupSize keys at a time, prefetches their words and then calls
+    // apply(index of the key in `elements`, groups, groupCount) for each key in order
+    template <typename Apply>
+    void for_each_group(std::span<const Key> elements, bool forWrite, Apply&& apply) const {
+        std::vector<CounterGroup> groups(batchGroupSize * maxHashFunctions);
+        std::array<std::size_t, batchGroupSize> groupCounts;
+
+        for (std::size_t groupStart = 0; groupStart < elements.size(); groupStart += batchGroupSize) {
+            std::size_t keysInGroup = std::min(batchGroupSize, elements.size() - groupStart);
+
+            for (std::size_t keyIndex = 0; keyIndex < keysInGroup; keyIndex++) {
+                CounterGroup* keyGroups = groups.data() + keyIndex * maxHashFunctions;
+                groupCounts[keyIndex] = group_counters(elements[groupStart + keyIndex], keyGroups);
+                for (std::size_t group = 0; group < groupCounts[keyIndex]; group++) {
+                    if (forWrite) bloom_prefetch_write(&counterStorage_[keyGroups[group].wordIndex]);
+                    else bloom_prefetch_read(&counterStorage_[keyGroups[group].wordIndex]);
+                }
+            }
+
+            for (std::size_t keyIndex = 0; keyIndex < keysInGroup; keyIndex++) {
+                apply(groupStart + keyIndex, groups.data() + keyIndex * maxHashFunctions, groupCounts[keyIndex]);
+            }
+        }
+    }
+
+    std::array<uint64_t, numWords> counterStorage_; // 4-bit counters, 16 per word
+    unsigned int numberOfHashFunctions_;            // Number of counters per key
+    HashFunction hasher_;                           // hash function functor
+};
+
+#endif  // COUNTING_BLOOM_FILTER_HPP
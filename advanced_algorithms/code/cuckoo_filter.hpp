@@ -0,0 +1,329 @@
+#ifndef CUCKOO_FILTER_HPP
+#define CUCKOO_FILTER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include "bloom_common.hpp"
+
+// CuckooFilter class template
+// Approximate membership like BloomFilter, but keys are stored as 16-bit fingerprints in a
+// cuckoo hash table (Fan et al., "Cuckoo Filter: Practically Better Than Bloom", 2014), so keys
+// can be erased and every lookup reads at most two buckets.
+// Each bucket holds 4 fingerprints packed into one 64-bit word; all 4 slots are compared at once
+// with SWAR (SIMD within a register) arithmetic. Fingerprint 0 marks an empty slot.
+// A key may be inserted more than once; each insert stores one more copy and each erase removes one.
+// Key: type of elements stored
+// HashFunction: hashing strategy (defaults to DefaultBloomHash, see bloom_common.hpp)
+template <typename Key, typename HashFunction = DefaultBloomHash<Key>>
+class CuckooFilter {
+public:
+    // Thrown when the filter is constructed with a capacity of zero
+    class Invalid {};
+
+    static constexpr std::size_t slotsPerBucket = 4;
+    static constexpr unsigned int fingerprintBits = 16;
+    static constexpr unsigned int maxKicks = 500;       // displacements tried before an insert fails
+    static constexpr double targetLoadFactor = 0.95;    // load a table of 4-slot buckets reliably reaches
+    static constexpr std::size_t batchGroupSize = 16;   // keys hashed and prefetched together
+
+    // Constructor: sizes the table so `expectedElementCount` keys fill it to targetLoadFactor
+    explicit CuckooFilter(uint64_t expectedElementCount) {
+        if (expectedElementCount == 0) {
+            throw Invalid{};
+        }
+        double minimumBuckets = static_cast<double>(expectedElementCount) / (slotsPerBucket * targetLoadFactor);
+        numBuckets_ = static_cast<uint64_t>(std::ceil(minimumBuckets));
+        bucketStorage_ = AlignedWordArray(numBuckets_);
+    }
+
+    // Constructor that takes an initializer list (e.g., {1, 2, 3}) and inserts keys into the filter
+    CuckooFilter(std::initializer_list<Key> initialKeys, uint64_t expectedElementCount)
+        : CuckooFilter(expectedElementCount) {
+        for (const Key& element : initialKeys) {
+            insert(element);
+        }
+    }
+
+    // Constructor that inserts keys using iterators from any container (e.g., vector, set)
+    template <typename Iterator>
+    CuckooFilter(Iterator iteratorBegin, Iterator iteratorEnd, uint64_t expectedElementCount)
+        : CuckooFilter(expectedElementCount) {
+        for (Iterator current = iteratorBegin; current != iteratorEnd; ++current) {
+            insert(*current);
+        }
+    }
+
+    // Inserts a key
+    // Returns false if the table is too full to take it; the failure is counted in failed_inserts()
+    bool insert(const Key& element) {
+        Slot slot = locate(element);
+        return store(slot.bucket, slot.fingerprint);
+    }
+
+    // Removes one copy of a key
+    // Returns false (and changes nothing) if the key is definitely not in the filter.
+    // Erasing a key that was never inserted may remove a different key with the same fingerprint.
+    bool erase(const Key& element) {
+        Slot slot = locate(element);
+        return remove(slot.bucket, slot.fingerprint);
+    }
+
+    // Checks if a key is *possibly* in the filter: at most two bucket reads
+    bool contains(const Key& element) const {
+        Slot slot = locate(element);
+        return holds(slot.bucket, slot.fingerprint);
+    }
+
+    // Inserts every key of the span, prefetching both candidate buckets of a group of keys first
+    // Returns the number of keys that were stored
+    std::size_t insert_batch(std::span<const Key> elements) {
+        std::size_t storedCount = 0;
+        for_each_group(elements, true, [&](std::size_t, const Slot& slot) {
+            if (store(slot.bucket, slot.fingerprint)) storedCount++;
+        });
+        return storedCount;
+    }
+
+    // Erases every key of the span; returns the number of keys that were actually erased
+    std::size_t erase_batch(std::span<const Key> elements) {
+        std::size_t erasedCount = 0;
+        for_each_group(elements, true, [&](std::size_t, const Slot& slot) {
+            if (remove(slot.bucket, slot.fingerprint)) erasedCount++;
+        });
+        return erasedCount;
+    }
+
+    // Looks up every key of the span; results[i] receives contains(elements[i])
+    void contains_batch(std::span<const Key> elements, std::span<bool> results) const {
+        assert(results.size() >= elements.size());
+        for_each_group(elements, false, [&](std::size_t keyIndex, const Slot& slot) {
+            results[keyIndex] = holds(slot.bucket, slot.fingerprint);
+        });
+    }
+
+    // Calculate false positive rate over a set of keys known not to be in the filter
+    // (the positives are accepted for interface parity with BloomFilter)
+    template <typename Iterator>
+    double false_positive_rate(
+        Iterator /*knownPositivesBegin*/, Iterator /*knownPositivesEnd*/,
+        Iterator knownNegativesBegin, Iterator knownNegativesEnd) const {
+
+        uint64_t falsePositiveCount = 0;
+        uint64_t totalNegativeSamples = 0;
+
+        for (Iterator it = knownNegativesBegin; it != knownNegativesEnd; ++it) {
+            totalNegativeSamples++;
+            if (contains(*it)) {
+                falsePositiveCount++;
+            }
+        }
+
+        if (totalNegativeSamples == 0) return 0.0; // Avoid division by zero
+
+        return static_cast<double>(falsePositiveCount) / static_cast<double>(totalNegativeSamples);
+    }
+
+    // Compares heap memory used by the table vs. storing the keys themselves
+    double space_ratio(uint64_t expectedElementCount) const {
+        std::size_t actualBitMemory = memory_bytes();
+        std::size_t optimalBitMemory = expectedElementCount * sizeof(Key);
+        return static_cast<double>(actualBitMemory) / static_cast<double>(optimalBitMemory);
+    }
+
+    // Number of fingerprints currently stored (exact, unlike the Bloom filter estimate)
+    uint64_t approx_size() const { return storedCount_; }
+
+    // Fraction of slots in use
+    double load_factor() const {
+        return static_cast<double>(storedCount_) / static_cast<double>(numBuckets_ * slotsPerBucket);
+    }
+
+    // Number of inserts rejected because the table was full
+    uint64_t failed_inserts() const { return failedInserts_; }
+
+    // Getter for the number of buckets
+    uint64_t num_buckets() const { return numBuckets_; }
+
+    // Heap bytes held by the buckets
+    std::size_t memory_bytes() const { return bucketStorage_.size() * sizeof(uint64_t); }
+
+private:
+    // First candidate bucket and fingerprint of a key
+    struct Slot {
+        uint64_t bucket;
+        uint64_t fingerprint;
+    };
+
+    static constexpr uint64_t lowLaneBits = 0x0001000100010001ULL;
+    static constexpr uint64_t highLaneBits = 0x8000800080008000ULL;
+    static constexpr uint64_t laneMask = 0xffffULL;
+
+    // Marks (with the lane's top bit) the 16-bit lanes of `bucket` equal to `fingerprint`
+    // The lowest marked lane is always a true match; lanes above it may be spurious,
+    // which is harmless for any-match tests and for picking the lowest lane
+    static uint64_t matching_lanes(uint64_t bucket, uint64_t fingerprint) {
+        uint64_t difference = bucket ^ (fingerprint * lowLaneBits);
+        return (difference - lowLaneBits) & ~difference & highLaneBits;
+    }
+
+    static unsigned int lowest_lane(uint64_t lanes) {
+        return static_cast<unsigned int>(std::countr_zero(lanes)) / fingerprintBits;
+    }
+
+    Slot locate(const Key& element) const {
+        BloomProbes<Key, HashFunction> probes(hasher_, element);
+        uint64_t fingerprint = probes(1) >> (64 - fingerprintBits);
+        if (fingerprint == 0) fingerprint = 1; // 0 is reserved for empty slots
+        return Slot{reduce_range(probes(0), numBuckets_), fingerprint};
+    }
+
+    // The other bucket a fingerprint may live in: (hash(fingerprint) - bucket) mod numBuckets
+    // Applying it twice returns the original bucket, and unlike the usual XOR form it does not
+    // need a power-of-two bucket count
+    uint64_t alternate_bucket(uint64_t bucket, uint64_t fingerprint) const {
+        uint64_t fingerprintHash = reduce_range(fmix64(fingerprint), numBuckets_);
+        return fingerprintHash >= bucket ? fingerprintHash - bucket : fingerprintHash + numBuckets_ - bucket;
+    }
+
+    bool holds(uint64_t bucket, uint64_t fingerprint) const {
+        uint64_t alternate = alternate_bucket(bucket, fingerprint);
+        if ((matching_lanes(bucketStorage_[bucket], fingerprint) |
+             matching_lanes(bucketStorage_[alternate], fingerprint)) != 0) {
+            return true;
+        }
+        return victim_.used && victim_.fingerprint == fingerprint &&
+            (victim_.bucket == bucket || victim_.bucket == alternate);
+    }
+
+    // Puts the fingerprint in a free slot of `bucket`; returns false if the bucket is full
+    bool try_place(uint64_t bucket, uint64_t fingerprint) {
+        uint64_t freeLanes = matching_lanes(bucketStorage_[bucket], 0);
+        if (freeLanes == 0) {
+            return false;
+        }
+        bucketStorage_[bucket] |= fingerprint << (lowest_lane(freeLanes) * fingerprintBits);
+        return true;
+    }
+
+    bool store(uint64_t bucket, uint64_t fingerprint) {
+        // While a displaced fingerprint waits in the victim slot the table counts as full
+        if (victim_.used) {
+            failedInserts_++;
+            return false;
+        }
+        storedCount_++;
+        if (try_place(bucket, fingerprint) || try_place(alternate_bucket(bucket, fingerprint), fingerprint)) {
+            return true;
+        }
+
+        // Both buckets full: evict a random resident to its other bucket and repeat
+        if (next_random() & 1) bucket = alternate_bucket(bucket, fingerprint);
+        for (unsigned int kick = 0; kick < maxKicks; kick++) {
+            unsigned int lane = next_random() % slotsPerBucket;
+            unsigned int shift = lane * fingerprintBits;
+            uint64_t evicted = (bucketStorage_[bucket] >> shift) & laneMask;
+            bucketStorage_[bucket] = (bucketStorage_[bucket] & ~(laneMask << shift)) | (fingerprint << shift);
+            fingerprint = evicted;
+            bucket = alternate_bucket(bucket, fingerprint);
+            if (try_place(bucket, fingerprint)) {
+                return true;
+            }
+        }
+
+        // The key itself is stored, but one displaced fingerprint is left over; keep it so that
+        // nothing already inserted turns into a false negative
+        victim_ = Victim{true, bucket, fingerprint};
+        return true;
+    }
+
+    bool remove(uint64_t bucket, uint64_t fingerprint) {
+        uint64_t alternate = alternate_bucket(bucket, fingerprint);
+        for (uint64_t candidate : {bucket, alternate}) {
+            uint64_t lanes = matching_lanes(bucketStorage_[candidate], fingerprint);
+            if (lanes != 0) {
+                bucketStorage_[candidate] &= ~(laneMask << (lowest_lane(lanes) * fingerprintBits));
+                storedCount_--;
+                reinsert_victim();
+                return true;
+            }
+        }
+        if (victim_.used && victim_.fingerprint == fingerprint &&
+            (victim_.bucket == bucket || victim_.bucket == alternate)) {
+            victim_.used = false;
+            storedCount_--;
+            return true;
+        }
+        return false;
+    }
+
+    // After an erase frees a slot, the waiting victim may fit again
+    void reinsert_victim() {
+        if (victim_.used) {
+            victim_.used = false;
+            storedCount_--;
+            store(victim_.bucket, victim_.fingerprint);
+        }
+    }
+
+    // xorshift64: picks which resident gets evicted
+    unsigned int next_random() {
+        kickState_ ^= kickState_ << 13;
+        kickState_ ^= kickState_ >> 7;
+        kickState_ ^= kickState_ << 17;
+        return static_cast<unsigned int>(kickState_ >> 32);
+    }
+
+    // Locates batchGroupSize keys at a time, prefetches both candidate buckets of each and then
+    // calls apply(index of the key in `elements`, slot) for each key in order
+    template <typename Apply>
+    void for_each_group(std::span<const Key> elements, bool forWrite, Apply&& apply) const {
+        std::array<Slot, batchGroupSize> slots;
+
+        for (std::size_t groupStart = 0; groupStart < elements.size(); groupStart += batchGroupSize) {
+            std::size_t keysInGroup = std::min(batchGroupSize, elements.size() - groupStart);
+
+            for (std::size_t keyIndex = 0; keyIndex < keysInGroup; keyIndex++) {
+                slots[keyIndex] = locate(elements[groupStart + keyIndex]);
+                const uint64_t* first = bucketStorage_.data() + slots[keyIndex].bucket;
+                const uint64_t* second = bucketStorage_.data() +
+                    alternate_bucket(slots[keyIndex].bucket, slots[keyIndex].fingerprint);
+                if (forWrite) {
+                    bloom_prefetch_write(first);
+                    bloom_prefetch_write(second);
+                }
+                else {
+                    bloom_prefetch_read(first);
+                    bloom_prefetch_read(second);
+                }
+            }
+
+            for (std::size_t keyIndex = 0; keyIndex < keysInGroup; keyIndex++) {
+                apply(groupStart + keyIndex, slots[keyIndex]);
+            }
+        }
+    }
+
+    // A fingerprint that found no slot after maxKicks displacements
+    struct Victim {
+        bool used = false;
+        uint64_t bucket = 0;
+        uint64_t fingerprint = 0;
+    };
+
+    uint64_t numBuckets_ = 0;
+    AlignedWordArray bucketStorage_;            // One bucket of 4 x 16-bit fingerprints per word
+    uint64_t storedCount_ = 0;                  // Fingerprints in the table, including the victim
+    uint64_t failedInserts_ = 0;
+    uint64_t kickState_ = 0x9e3779b97f4a7c15ULL;
+    Victim victim_;
+    HashFunction hasher_;                       // hash function functor
+};
+
+#endif  // CUCKOO_FILTER_HPP
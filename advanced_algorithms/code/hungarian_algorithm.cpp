@@ -1,4 +1,6 @@
-#include "munkres_algorithm.hpp"
+#include "hungarian_algorithm.hpp"
+#include "assignment_solver.hpp"
+#include "matrix_expression.hpp"
 #include <vector>
 #include <limits>
 #include <iostream>
@@ -21,32 +23,18 @@ Matrix<int> run_munkres_algorithm(Matrix<int> costMatrix) {
     std::vector<bool> isColumnCurrentlyCovered(matrixSize, false);
 
     // subtract the minimum value from each row
-    for (int currentRow = 0; currentRow < matrixSize; currentRow++) {
-        int minimumRowValue = costMatrix(currentRow, 0);
-
-        for (int currentColumn = 1; currentColumn < matrixSize; currentColumn++) {
-            if (costMatrix(currentRow, currentColumn) < minimumRowValue) {
-                minimumRowValue = costMatrix(currentRow, currentColumn);
-            }
-        }
-
-        for (int currentColumn = 0; currentColumn < matrixSize; currentColumn++) {
-            costMatrix(currentRow, currentColumn) -= minimumRowValue;
+    const std::vector<int> minimumRowValues = row_min(costMatrix);
+    for (std::size_t currentRow = 0; currentRow < costMatrix.nrows(); currentRow++) {
+        for (std::size_t currentColumn = 0; currentColumn < costMatrix.ncols(); currentColumn++) {
+            costMatrix(currentRow, currentColumn) -= minimumRowValues[currentRow];
         }
     }
 
-    // Subtract the minimum value from each column
-    for (int currentColumn = 0; currentColumn < matrixSize; currentColumn++) {
-        int minimumColumnValue = costMatrix(0, currentColumn);
-
-        for (int currentRow = 1; currentRow < matrixSize; currentRow++) {
-            if (costMatrix(currentRow, currentColumn) < minimumColumnValue) {
-                minimumColumnValue = costMatrix(currentRow, currentColumn);
-            }
-        }
-
-        for (int currentRow = 0; currentRow < matrixSize; currentRow++) {
-            costMatrix(currentRow, currentColumn) -= minimumColumnValue;
+    // Subtract the minimum value from each column (row by row, so every pass is contiguous)
+    const std::vector<int> minimumColumnValues = col_min(costMatrix);
+    for (std::size_t currentRow = 0; currentRow < costMatrix.nrows(); currentRow++) {
+        for (std::size_t currentColumn = 0; currentColumn < costMatrix.ncols(); currentColumn++) {
+            costMatrix(currentRow, currentColumn) -= minimumColumnValues[currentColumn];
         }
     }
 
@@ -252,3 +240,19 @@ Matrix<int> run_munkres_algorithm(Matrix<int> costMatrix) {
 
     return resultAssignmentMatrix;
 }
+
+Matrix<int> run_jonker_volgenant_algorithm(const Matrix<int>& costMatrix) {
+
+    AssignmentResult<int> assignment = solve_assignment(costMatrix);
+
+    // Return the final assignment matrix
+    Matrix<int> resultAssignmentMatrix(costMatrix.nrows(), costMatrix.ncols(), 0);
+
+    for (std::size_t row = 0; row < costMatrix.nrows(); row++) {
+        if (assignment.rowToColumn[row] != -1) { // rows beyond the number of columns stay unassigned
+            resultAssignmentMatrix(row, static_cast<std::size_t>(assignment.rowToColumn[row])) = 1;
+        }
+    }
+
+    return resultAssignmentMatrix;
+}
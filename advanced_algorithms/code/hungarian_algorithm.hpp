@@ -1,8 +1,18 @@
-#ifndef MUNKRES_ALGORITHM_HPP
-#define MUNKRES_ALGORITHM_HPP
+#ifndef HUNGARIAN_ALGORITHM_HPP
+#define HUNGARIAN_ALGORITHM_HPP
 
 #include "matrix.hpp"
 
+// Both solvers return a 0/1 matrix of the cost matrix's shape marking an assignment of minimum
+// total cost, with exactly one 1 per row and column of a square input.
+
+// Classic Munkres star/prime algorithm (kept for cross-checking); O(n^4) in practice
+// Throws Matrix<int>::Invalid if the matrix is not square
 Matrix<int> run_munkres_algorithm(Matrix<int> c);
 
-#endif //MUNKRES_ALGORITHM_HPP
+// Jonker-Volgenant style shortest augmenting paths over dual potentials; O(n^3)
+// Also takes n x m matrices: every row (n <= m) or every column (n > m) then holds exactly one 1
+// (wraps solve_assignment from assignment_solver.hpp, which takes any cost type and returns a compact result)
+Matrix<int> run_jonker_volgenant_algorithm(const Matrix<int>& costMatrix);
+
+#endif //HUNGARIAN_ALGORITHM_HPP
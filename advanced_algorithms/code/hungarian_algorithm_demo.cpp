@@ -1,29 +1,55 @@
 #include <iostream>
 
-#include "munkres_algorithm.hpp"
+#include "assignment_solver.hpp"
+#include "hungarian_algorithm.hpp"
 #include "matrix.hpp"
 
 
+// Returns true if both matrices have the same shape and entries
+static bool same_matrix(const Matrix<int>& lhs, const Matrix<int>& rhs) {
+    if(lhs.nrows() != rhs.nrows() || lhs.ncols() != rhs.ncols()) {
+        return false;
+    }
+
+    for(size_t i = 0; i < lhs.nrows(); i++) {
+        for(size_t j = 0; j < lhs.ncols(); j++) {
+            if(lhs(i,j) != rhs(i,j)){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 int main(int /*argc*/, const char* /*argv*/[]) {
     const Matrix<int> m = {{250, 400, 350}, {400, 600, 350}, {200, 400, 250}};
     const Matrix<int> s = {{0, 1, 0}, {0, 0, 1}, {1, 0, 0}};
 
     const auto res = run_munkres_algorithm(m);
+    const auto jvRes = run_jonker_volgenant_algorithm(m);
 
-    if(s.nrows() != res.nrows() || s.ncols() != res.ncols()) {
-        std::cerr << "Cannot compare matrices" << std::endl;
+    if(!same_matrix(s, res)) {
+        std::cerr << "Found invalid result (Munkres)" << std::endl;
+        return 1;
+    }
+    if(!same_matrix(s, jvRes)) {
+        std::cerr << "Found invalid result (Jonker-Volgenant)" << std::endl;
         return 1;
     }
 
+    // The generic solver on the same costs in dollars, returning row -> column and the total
+    const Matrix<double> dollars = {{2.50, 4.00, 3.50}, {4.00, 6.00, 3.50}, {2.00, 4.00, 2.50}};
+    const AssignmentResult<double> compact = solve_assignment(dollars);
     for(size_t i = 0; i < s.nrows(); i++) {
-        for(size_t j = 0; j < s.ncols(); j++) {
-            if(s(i,j) != res(i,j)){
-                std::cerr << "Found invalid result" << std::endl;
-                return 1;
-            }
+        if(s(i, static_cast<size_t>(compact.rowToColumn[i])) != 1) {
+            std::cerr << "Found invalid result (solve_assignment)" << std::endl;
+            return 1;
         }
     }
+
     std::cout << "Expected matrix:\n" << s << std::endl;
-    std::cout << "Result matrix:\n" << res << std::endl;
+    std::cout << "Result matrix (Munkres):\n" << res << std::endl;
+    std::cout << "Result matrix (Jonker-Volgenant):\n" << jvRes << std::endl;
+    std::cout << "Total cost (solve_assignment): " << compact.totalCost << std::endl;
     return 0;
 }
@@ -0,0 +1,186 @@
+#ifndef INCREMENTAL_ASSIGNMENT_HPP
+#define INCREMENTAL_ASSIGNMENT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "assignment_solver.hpp"
+#include "matrix.hpp"
+
+// IncrementalAssignment class template
+// Keeps an optimal assignment of rows to columns (rows <= columns) together with its dual
+// potentials, and repairs it after each change instead of re-solving:
+// - update_cost: frees the row, makes its potential feasible again and runs one shortest
+//   augmenting path (nothing at all if the pair is unassigned and its reduced cost stays >= 0)
+// - add_row / remove_row: same single augmentation for the row that appears or disappears
+// Each repair costs O(columns * rows visited by the path), against O(n^3) for a fresh solve.
+// Internally the problem is square: columns - rows zero-cost "spare" rows hold the columns no real
+// row uses, so freeing or taking a column never breaks the optimality conditions. Spare rows store
+// no costs (an empty row reads as all zeros), and nothing points into the object's own storage,
+// so copies and moves are independent.
+// Cost: one of the AssignmentCost types (int32_t, int64_t, float, double)
+template <AssignmentCost Cost>
+class IncrementalAssignment {
+public:
+    // Thrown on a shape mismatch, an out-of-range index or more rows than columns
+    class Invalid {};
+
+    using Sum = AssignmentSum<Cost>;
+
+    // Constructor: no rows yet, `columnCount` columns
+    explicit IncrementalAssignment(std::size_t columnCount)
+        : IncrementalAssignment(0, columnCount, [](std::size_t, std::size_t) { return Cost{}; }) {
+    }
+
+    // Constructor: solves an n x m cost matrix from scratch (n <= m)
+    explicit IncrementalAssignment(const Matrix<Cost>& costMatrix)
+        : IncrementalAssignment(costMatrix.nrows(), costMatrix.ncols(),
+            [&](std::size_t row, std::size_t column) { return costMatrix(row, column); }) {
+    }
+
+    // Sets cost(row, column) and restores the optimum
+    void update_cost(std::size_t row, std::size_t column, Cost cost) {
+        if (row >= slotOfRow_.size() || column >= columnCount_) {
+            throw Invalid{};
+        }
+        std::size_t slot = slotOfRow_[row];
+        rowCosts_[slot][column] = cost;
+
+        // An unassigned pair whose reduced cost stays non-negative cannot improve the assignment
+        bool isAssignedPair = duals_.columnOfRow[slot] == column;
+        if (!isAssignedPair &&
+            static_cast<Sum>(cost) >= duals_.rowPotential[slot] + duals_.columnPotential[column]) {
+            return;
+        }
+        reassign(slot);
+    }
+
+    // Appends a row with the given costs (one per column) and restores the optimum
+    // Returns the index of the new row. Throws Invalid if every column already has a row
+    std::size_t add_row(std::span<const Cost> costs) {
+        if (costs.size() != columnCount_ || slotOfRow_.size() == columnCount_) {
+            throw Invalid{};
+        }
+        // Any spare slot will do; the last one keeps the lookup O(1)
+        std::size_t slot = spareSlots_.back();
+        spareSlots_.pop_back();
+
+        rowCosts_[slot].assign(costs.begin(), costs.end());
+        slotOfRow_.push_back(slot);
+        reassign(slot);
+        return slotOfRow_.size() - 1;
+    }
+
+    // Removes a row and restores the optimum; rows after it move up by one
+    void remove_row(std::size_t row) {
+        if (row >= slotOfRow_.size()) {
+            throw Invalid{};
+        }
+        std::size_t slot = slotOfRow_[row];
+        slotOfRow_.erase(slotOfRow_.begin() + static_cast<std::ptrdiff_t>(row));
+
+        // The slot becomes a spare row: all costs zero, no storage
+        rowCosts_[slot].clear();
+        rowCosts_[slot].shrink_to_fit();
+        spareSlots_.push_back(slot);
+        reassign(slot);
+    }
+
+    // Column currently assigned to `row`
+    std::size_t column_of(std::size_t row) const { return duals_.columnOfRow[slotOfRow_.at(row)]; }
+
+    // Current cost of a pair
+    Cost cost(std::size_t row, std::size_t column) const { return rowCosts_[slotOfRow_.at(row)][column]; }
+
+    // Sum of the assigned costs
+    Sum total_cost() const {
+        Sum totalCost = 0;
+        for (std::size_t slot : slotOfRow_) {
+            totalCost += static_cast<Sum>(rowCosts_[slot][duals_.columnOfRow[slot]]);
+        }
+        return totalCost;
+    }
+
+    // Current assignment in the format of solve_assignment
+    AssignmentResult<Cost> result() const {
+        AssignmentResult<Cost> assignment;
+        assignment.rowToColumn.reserve(slotOfRow_.size());
+        for (std::size_t slot : slotOfRow_) {
+            assignment.rowToColumn.push_back(static_cast<int>(duals_.columnOfRow[slot]));
+        }
+        assignment.totalCost = total_cost();
+        return assignment;
+    }
+
+    // Getter for number of rows
+    std::size_t nrows() const { return slotOfRow_.size(); }
+
+    // Getter for number of columns
+    std::size_t ncols() const { return columnCount_; }
+
+private:
+    template <typename CostAt>
+    IncrementalAssignment(std::size_t rowCount, std::size_t columnCount, CostAt costAt)
+        : columnCount_(checked_column_count(rowCount, columnCount)),
+        rowCosts_(columnCount),
+        duals_(assignment_detail::shortest_augmenting_paths<Sum>(rowCount, columnCount, costAt)),
+        search_(columnCount) {
+
+        for (std::size_t row = 0; row < rowCount; row++) {
+            rowCosts_[row].resize(columnCount);
+            for (std::size_t column = 0; column < columnCount; column++) {
+                rowCosts_[row][column] = costAt(row, column);
+            }
+            slotOfRow_.push_back(row);
+        }
+
+        // Spare rows take the columns left over; hand out low slots first
+        assignment_detail::add_spare_rows(duals_);
+        for (std::size_t slot = columnCount; slot-- > rowCount;) {
+            spareSlots_.push_back(slot);
+        }
+    }
+
+    // Validates the shape before anything is solved
+    static std::size_t checked_column_count(std::size_t rowCount, std::size_t columnCount) {
+        if (columnCount == 0 || rowCount > columnCount) {
+            throw Invalid{};
+        }
+        return columnCount;
+    }
+
+    // Cost of a pair by slot; spare slots (no stored costs) cost zero everywhere
+    Cost slot_cost(std::size_t slot, std::size_t column) const {
+        const std::vector<Cost>& costs = rowCosts_[slot];
+        return costs.empty() ? Cost{} : costs[column];
+    }
+
+    // Frees `slot`, gives it the largest feasible potential and assigns it along one shortest
+    // augmenting path. Every other pair keeps its reduced cost, so the result is optimal again
+    void reassign(std::size_t slot) {
+        std::size_t column = duals_.columnOfRow[slot];
+        duals_.rowOfColumn[column] = assignment_detail::unassigned;
+        duals_.columnOfRow[slot] = assignment_detail::unassigned;
+
+        Sum rowPotential = static_cast<Sum>(slot_cost(slot, 0)) - duals_.columnPotential[0];
+        for (std::size_t otherColumn = 1; otherColumn < columnCount_; otherColumn++) {
+            rowPotential = std::min(rowPotential,
+                static_cast<Sum>(slot_cost(slot, otherColumn)) - duals_.columnPotential[otherColumn]);
+        }
+        duals_.rowPotential[slot] = rowPotential;
+
+        search_.augment(duals_, slot,
+            [this](std::size_t row, std::size_t otherColumn) { return slot_cost(row, otherColumn); },
+            assignment_detail::AllPairsAllowed{});
+    }
+
+    std::size_t columnCount_;
+    std::vector<std::vector<Cost>> rowCosts_;        // costs of each slot holding a real row, empty for spare slots
+    std::vector<std::size_t> slotOfRow_;             // slot of each real row, in row order
+    std::vector<std::size_t> spareSlots_;            // slots without a real row
+    assignment_detail::AssignmentDuals<Sum> duals_;  // potentials and matching over all columnCount slots
+    assignment_detail::AugmentingPathSearch<Sum> search_;
+};
+
+#endif  // INCREMENTAL_ASSIGNMENT_HPP
@@ -0,0 +1,267 @@
+#ifndef KBEST_ASSIGNMENT_HPP
+#define KBEST_ASSIGNMENT_HPP
+
+#include <algorithm>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "assignment_solver.hpp"
+#include "matrix.hpp"
+
+// k best assignments by Murty's partitioning
+// The solution space of a subproblem (some pairs forced, some forbidden) is split around its
+// optimal assignment: with free rows r1 .. rt, child i forces the assignment's pairs of r1 .. r(i-1)
+// and forbids the pair of ri. Every other assignment lies in exactly one child, so popping
+// subproblems cheapest-first yields the assignments in order of cost.
+// Each child starts from a copy of its parent's optimal duals: forbidding a pair only removes an
+// edge, so the potentials stay feasible, and one shortest augmenting path for ri restores the
+// optimum. The cost matrix is never copied; subproblems differ only in their constraint lists,
+// which a per-thread mask applies during the augmentation.
+
+namespace assignment_detail {
+
+// A (row, column) pair that a subproblem forces or forbids
+struct AssignmentConstraint {
+    std::size_t row;
+    std::size_t column;
+};
+
+// One subproblem of the partition together with its optimal solution
+template <typename Sum>
+struct MurtyNode {
+    AssignmentDuals<Sum> duals;                   // optimal potentials and matching (square, with spare rows)
+    std::vector<AssignmentConstraint> forced;     // pairs every solution of the subproblem contains
+    std::vector<AssignmentConstraint> forbidden;  // pairs no solution of the subproblem contains
+};
+
+// ConstraintMask class
+// Forced and forbidden pairs of one subproblem over the shared cost matrix: the forced column of
+// each row plus a bit per (row, column) pair. Applying and clearing cost O(number of constraints)
+class ConstraintMask {
+public:
+    ConstraintMask(std::size_t rowCount, std::size_t columnCount)
+        : rowCount_(rowCount), columnCount_(columnCount), forcedColumn_(rowCount, unassigned),
+        forbiddenBits_((rowCount * columnCount + 63) / 64, 0) {
+    }
+
+    void apply(const std::vector<AssignmentConstraint>& forced, const std::vector<AssignmentConstraint>& forbidden) {
+        for (const AssignmentConstraint& pair : forced) {
+            forcedColumn_[pair.row] = pair.column;
+        }
+        for (const AssignmentConstraint& pair : forbidden) {
+            std::size_t bit = pair.row * columnCount_ + pair.column;
+            forbiddenBits_[bit / 64] |= uint64_t{1} << (bit % 64);
+        }
+    }
+
+    void clear(const std::vector<AssignmentConstraint>& forced, const std::vector<AssignmentConstraint>& forbidden) {
+        for (const AssignmentConstraint& pair : forced) {
+            forcedColumn_[pair.row] = unassigned;
+        }
+        for (const AssignmentConstraint& pair : forbidden) {
+            std::size_t bit = pair.row * columnCount_ + pair.column;
+            forbiddenBits_[bit / 64] &= ~(uint64_t{1} << (bit % 64));
+        }
+    }
+
+    // Spare rows (row >= rowCount) are never constrained
+    bool allows(std::size_t row, std::size_t column) const {
+        if (row >= rowCount_) {
+            return true;
+        }
+        if (forcedColumn_[row] != unassigned) {
+            return forcedColumn_[row] == column;
+        }
+        std::size_t bit = row * columnCount_ + column;
+        return ((forbiddenBits_[bit / 64] >> (bit % 64)) & 1) == 0;
+    }
+
+private:
+    std::size_t rowCount_;
+    std::size_t columnCount_;
+    std::vector<std::size_t> forcedColumn_;   // unassigned if the row is not forced
+    std::vector<uint64_t> forbiddenBits_;     // rowCount x columnCount bits, row-major
+};
+
+} // namespace assignment_detail
+
+// Returns the k lowest-cost assignments of an n x m cost matrix (n <= m), cheapest first; fewer
+// if there are not that many. Equal costs come out in a fixed order, the same for any number of
+// threads.
+// threadCount > 1 solves the children of each subproblem in parallel (0 = one thread per
+// hardware thread).
+// Throws Matrix<Cost>::Invalid if there are more rows than columns
+template <AssignmentCost Cost>
+std::vector<AssignmentResult<Cost>> k_best_assignments(const Matrix<Cost>& costMatrix, std::size_t k,
+    unsigned int threadCount = 1) {
+
+    using Sum = AssignmentSum<Cost>;
+    using Node = assignment_detail::MurtyNode<Sum>;
+    using assignment_detail::AssignmentConstraint;
+
+    const std::size_t rowCount = costMatrix.nrows();
+    const std::size_t columnCount = costMatrix.ncols();
+    if (rowCount > columnCount) {
+        throw typename Matrix<Cost>::Invalid{};
+    }
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Spare rows cost nothing anywhere
+    auto costAt = [&](std::size_t row, std::size_t column) {
+        return row < rowCount ? costMatrix(row, column) : Cost{};
+    };
+    auto total_cost = [&](const assignment_detail::AssignmentDuals<Sum>& duals) {
+        Sum totalCost = 0;
+        for (std::size_t row = 0; row < rowCount; row++) {
+            totalCost += static_cast<Sum>(costMatrix(row, duals.columnOfRow[row]));
+        }
+        return totalCost;
+    };
+
+    std::vector<AssignmentResult<Cost>> results;
+    if (k == 0) {
+        return results;
+    }
+
+    // Open subproblems keyed by (cost, creation order). Only the k - results.size() cheapest can
+    // still contribute, so the map never grows past that
+    std::map<std::pair<Sum, std::size_t>, Node> openNodes;
+    std::size_t nodesCreated = 0;
+
+    Node root{assignment_detail::shortest_augmenting_paths<Sum>(rowCount, columnCount, costAt), {}, {}};
+    assignment_detail::add_spare_rows(root.duals);
+    openNodes.emplace(std::make_pair(total_cost(root.duals), nodesCreated++), std::move(root));
+
+    // Children of the node being expanded; a child without solution was infeasible
+    Node parent{assignment_detail::AssignmentDuals<Sum>(0, 0), {}, {}};
+    std::vector<std::size_t> partitionRows;
+    std::vector<Node> children;
+    std::vector<bool> isChildFeasible;
+
+    // Solves children[begin, end) with one augmentation each from the parent's duals
+    auto solve_children = [&](std::size_t begin, std::size_t end, assignment_detail::ConstraintMask& mask,
+        assignment_detail::AugmentingPathSearch<Sum>& search) {
+
+        for (std::size_t childIndex = begin; childIndex < end; childIndex++) {
+            Node& child = children[childIndex];
+            std::size_t row = partitionRows[childIndex];
+            std::size_t column = parent.duals.columnOfRow[row];
+
+            child.duals = parent.duals;
+            child.duals.rowOfColumn[column] = assignment_detail::unassigned;
+            child.duals.columnOfRow[row] = assignment_detail::unassigned;
+
+            mask.apply(child.forced, child.forbidden);
+            isChildFeasible[childIndex] = search.augment(child.duals, row, costAt,
+                [&mask](std::size_t maskRow, std::size_t maskColumn) { return mask.allows(maskRow, maskColumn); });
+            mask.clear(child.forced, child.forbidden);
+        }
+    };
+
+    // Workers wait at the barrier for a node, solve their slice of its children and meet again;
+    // the calling thread is worker 0
+    std::barrier roundBarrier(static_cast<std::ptrdiff_t>(threadCount));
+    bool finished = false;
+    auto solve_slice = [&](unsigned int threadIndex, assignment_detail::ConstraintMask& mask,
+        assignment_detail::AugmentingPathSearch<Sum>& search) {
+        solve_children(children.size() * threadIndex / threadCount,
+            children.size() * (threadIndex + 1) / threadCount, mask, search);
+    };
+
+    std::vector<std::jthread> workers;
+    workers.reserve(threadCount - 1);
+    for (unsigned int threadIndex = 1; threadIndex < threadCount; threadIndex++) {
+        workers.emplace_back([&, threadIndex] {
+            assignment_detail::ConstraintMask mask(rowCount, columnCount);
+            assignment_detail::AugmentingPathSearch<Sum> search(columnCount);
+            while (true) {
+                roundBarrier.arrive_and_wait();
+                if (finished) {
+                    return;
+                }
+                solve_slice(threadIndex, mask, search);
+                roundBarrier.arrive_and_wait();
+            }
+        });
+    }
+    assignment_detail::ConstraintMask mask(rowCount, columnCount);
+    assignment_detail::AugmentingPathSearch<Sum> search(columnCount);
+
+    while (!openNodes.empty() && results.size() < k) {
+        auto cheapest = openNodes.begin();
+        parent = std::move(cheapest->second);
+
+        AssignmentResult<Cost> assignment;
+        assignment.totalCost = cheapest->first.first;
+        assignment.rowToColumn.reserve(rowCount);
+        for (std::size_t row = 0; row < rowCount; row++) {
+            assignment.rowToColumn.push_back(static_cast<int>(parent.duals.columnOfRow[row]));
+        }
+        results.push_back(std::move(assignment));
+        openNodes.erase(cheapest);
+        if (results.size() == k) {
+            break;
+        }
+
+        // Partition around the parent's assignment, over the rows it does not force
+        partitionRows.clear();
+        for (std::size_t row = 0; row < rowCount; row++) {
+            bool isForced = std::any_of(parent.forced.begin(), parent.forced.end(),
+                [row](const AssignmentConstraint& pair) { return pair.row == row; });
+            if (!isForced) {
+                partitionRows.push_back(row);
+            }
+        }
+
+        children.clear();
+        std::vector<AssignmentConstraint> forcedPrefix = parent.forced;
+        for (std::size_t row : partitionRows) {
+            Node child{assignment_detail::AssignmentDuals<Sum>(0, 0), forcedPrefix, parent.forbidden};
+            child.forbidden.push_back({row, parent.duals.columnOfRow[row]});
+            children.push_back(std::move(child));
+            forcedPrefix.push_back({row, parent.duals.columnOfRow[row]});
+        }
+        isChildFeasible.assign(children.size(), false);
+
+        if (threadCount > 1) {
+            roundBarrier.arrive_and_wait();
+            solve_slice(0, mask, search);
+            roundBarrier.arrive_and_wait();
+        }
+        else {
+            solve_children(0, children.size(), mask, search);
+        }
+
+        // Keep the children in creation order so ties resolve the same way on any thread count
+        std::size_t stillNeeded = k - results.size();
+        for (std::size_t childIndex = 0; childIndex < children.size(); childIndex++) {
+            if (!isChildFeasible[childIndex]) {
+                continue;
+            }
+            Sum childCost = total_cost(children[childIndex].duals);
+            std::pair<Sum, std::size_t> key(childCost, nodesCreated++);
+            if (openNodes.size() == stillNeeded && !(key < std::prev(openNodes.end())->first)) {
+                continue; // cannot be among the remaining k
+            }
+            openNodes.emplace(key, std::move(children[childIndex]));
+            if (openNodes.size() > stillNeeded) {
+                openNodes.erase(std::prev(openNodes.end()));
+            }
+        }
+    }
+
+    finished = true;
+    if (threadCount > 1) {
+        roundBarrier.arrive_and_wait(); // release the workers; the jthreads join on destruction
+    }
+    return results;
+}
+
+#endif  // KBEST_ASSIGNMENT_HPP
@@ -0,0 +1,145 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "assignment_solver.hpp"
+#include "kbest_assignment.hpp"
+#include "matrix.hpp"
+
+// k best assignments: Murty with warm-started children (k_best_assignments, 1 thread and all
+// threads) against the same partitioning where every child is a modified copy of the cost
+// matrix solved from scratch. All three must return the same k costs.
+// usage: a4_kbest_assignment_benchmark [k] [max cost]
+
+namespace {
+
+struct Constraint {
+    std::size_t row;
+    std::size_t column;
+};
+
+struct ColdNode {
+    std::vector<int> rowToColumn;
+    std::vector<Constraint> forced;
+    std::vector<Constraint> forbidden;
+};
+
+// Murty's partitioning with a full copy and re-solve per child; forced and forbidden pairs are
+// expressed through a prohibitive cost
+std::vector<int64_t> cold_k_best_costs(const Matrix<int>& costMatrix, std::size_t k, int prohibitiveCost) {
+    const std::size_t size = costMatrix.nrows();
+    std::multimap<int64_t, ColdNode> openNodes;
+    std::vector<int64_t> costs;
+
+    auto solve_child = [&](const std::vector<Constraint>& forced, const std::vector<Constraint>& forbidden) {
+        Matrix<int> constrained = costMatrix;
+        for (const Constraint& pair : forced) {
+            for (std::size_t col = 0; col < size; col++) {
+                if (col != pair.column) {
+                    constrained(pair.row, col) = prohibitiveCost;
+                }
+            }
+        }
+        for (const Constraint& pair : forbidden) {
+            constrained(pair.row, pair.column) = prohibitiveCost;
+        }
+        return solve_assignment(constrained);
+    };
+
+    AssignmentResult<int> root = solve_assignment(costMatrix);
+    openNodes.emplace(root.totalCost, ColdNode{root.rowToColumn, {}, {}});
+
+    while (!openNodes.empty() && costs.size() < k) {
+        ColdNode parent = openNodes.begin()->second;
+        costs.push_back(openNodes.begin()->first);
+        openNodes.erase(openNodes.begin());
+
+        std::vector<Constraint> forcedPrefix = parent.forced;
+        for (std::size_t row = 0; row < size; row++) {
+            bool isForced = false;
+            for (const Constraint& pair : parent.forced) {
+                isForced = isForced || pair.row == row;
+            }
+            if (isForced) {
+                continue;
+            }
+            std::vector<Constraint> forbidden = parent.forbidden;
+            Constraint pair{row, static_cast<std::size_t>(parent.rowToColumn[row])};
+            forbidden.push_back(pair);
+
+            AssignmentResult<int> child = solve_child(forcedPrefix, forbidden);
+            if (child.totalCost < prohibitiveCost) {
+                openNodes.emplace(child.totalCost, ColdNode{child.rowToColumn, forcedPrefix, forbidden});
+            }
+            forcedPrefix.push_back(pair);
+        }
+    }
+    return costs;
+}
+
+template <typename Solve>
+double seconds_for(Solve solve) {
+    auto start = std::chrono::steady_clock::now();
+    solve();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, const char* argv[]) {
+    std::size_t k = argc > 1 ? std::stoul(argv[1]) : 100;
+    int maxCost = argc > 2 ? std::stoi(argv[2]) : 1000;
+    unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    const std::size_t sizes[] = {20, 50, 100, 200};
+    std::mt19937 generator(2024);
+    std::uniform_int_distribution<int> costDistribution(0, maxCost);
+
+    std::cout << "k = " << k << '\n' << std::setw(6) << "n" << std::setw(14) << "k-th cost"
+        << std::setw(14) << "warm [s]" << std::setw(10) << "warm [s]" << std::setw(14) << "cold [s]"
+        << std::setw(10) << "speedup" << '\n'
+        << std::setw(34) << "1 thread" << std::setw(10) << maxThreads << '\n';
+
+    for (std::size_t size : sizes) {
+        Matrix<int> costMatrix(size, size, uninitialized);
+        for (std::size_t row = 0; row < size; row++) {
+            for (std::size_t col = 0; col < size; col++) {
+                costMatrix(row, col) = costDistribution(generator);
+            }
+        }
+        int prohibitiveCost = maxCost * static_cast<int>(size) + 1;
+
+        std::vector<AssignmentResult<int>> warm;
+        std::vector<AssignmentResult<int>> parallel;
+        std::vector<int64_t> cold;
+        double warmSeconds = seconds_for([&] { warm = k_best_assignments(costMatrix, k, 1); });
+        double parallelSeconds = seconds_for([&] { parallel = k_best_assignments(costMatrix, k, maxThreads); });
+        double coldSeconds = seconds_for([&] { cold = cold_k_best_costs(costMatrix, k, prohibitiveCost); });
+
+        if (warm.size() != cold.size() || parallel.size() != warm.size()) {
+            std::cerr << "Different number of assignments for n = " << size << std::endl;
+            return 1;
+        }
+        for (std::size_t rank = 0; rank < warm.size(); rank++) {
+            if (warm[rank].totalCost != cold[rank] || parallel[rank].rowToColumn != warm[rank].rowToColumn) {
+                std::cerr << "Assignment " << rank << " differs for n = " << size << std::endl;
+                return 1;
+            }
+        }
+
+        std::cout << std::setw(6) << size << std::setw(14) << warm.back().totalCost
+            << std::fixed << std::setprecision(4) << std::setw(14) << warmSeconds << std::setw(10) << parallelSeconds
+            << std::setw(14) << coldSeconds << std::setprecision(1) << std::setw(9) << coldSeconds / warmSeconds
+            << 'x' << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#ifndef MAPPED_BLOOM_FILTER_HPP
+#define MAPPED_BLOOM_FILTER_HPP
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "bloom_common.hpp"
+#include "bloom_file.hpp"
+
+// MappedBloomFilter class template
+// Read-only Bloom filter that answers contains() straight from an mmap'd file written by
+// BloomFilter::save, BlockedBloomFilter::save or RuntimeBloomFilter::save. Nothing is copied:
+// every process that opens the same file shares one page-cache copy of the bits.
+// Key and HashFunction must match the filter that wrote the file; open_mapped checks this.
+template <typename Key, PersistableHashPolicy HashFunction = DefaultBloomHash<Key>>
+class MappedBloomFilter {
+public:
+    // Maps `path` and validates its header
+    // Throws std::runtime_error if the file is missing, truncated or written with another
+    // version, byte order, key size or hashing policy
+    static MappedBloomFilter open_mapped(const std::string& path) {
+        MappedFile file(path);
+        if (file.size() < sizeof(BloomFileHeader)) {
+            throw std::runtime_error(path + " is too small to be a Bloom filter file");
+        }
+
+        BloomFileHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        if (std::memcmp(header.magic, BloomFileHeader::expectedMagic, sizeof(header.magic)) != 0) {
+            throw std::runtime_error(path + " is not a Bloom filter file");
+        }
+        if (header.byteOrderMark != BloomFileHeader::expectedByteOrderMark) {
+            throw std::runtime_error(path + " was written on a host with a different byte order");
+        }
+        if (header.version != BloomFileHeader::currentVersion) {
+            throw std::runtime_error(path + " has unsupported format version " + std::to_string(header.version));
+        }
+        if (header.hashPolicy != HashFunction::policyId || header.hashSeed != HashFunction::seed ||
+            header.keySize != sizeof(Key)) {
+            throw std::runtime_error(path + " was written with a different key type or hashing policy");
+        }
+        if (header.layout != static_cast<uint32_t>(BloomLayout::plain) &&
+            header.layout != static_cast<uint32_t>(BloomLayout::blocked)) {
+            throw std::runtime_error(path + " has an unknown bit layout");
+        }
+        if (header.numBits == 0 || header.numberOfHashFunctions == 0 ||
+            header.wordCount < header.numBits / 64 + (header.numBits % 64 != 0) ||
+            (header.layout == static_cast<uint32_t>(BloomLayout::blocked) && header.numBits % 512 != 0) ||
+            header.wordCount > (file.size() - sizeof(BloomFileHeader)) / sizeof(uint64_t)) {
+            throw std::runtime_error(path + " is truncated or inconsistent");
+        }
+
+        return MappedBloomFilter(std::move(file), header);
+    }
+
+    // Checks if a key is *possibly* in the filter
+    bool contains(const Key& element) const {
+        BloomProbes<Key, HashFunction> probes(hasher_, element);
+
+        if (layout_ == BloomLayout::blocked) {
+            const uint64_t* block = words_ + reduce_range(probes(0), numBits_ / 512) * 8;
+            for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
+                uint64_t bitInBlock = (probes(hashIndex + 1) >> 32) % 512;
+                if (((block[bitInBlock / 64] >> (bitInBlock % 64)) & 1) == 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
+            uint64_t bitPosition = reduce_range(probes(hashIndex), numBits_);
+            if (((words_[bitPosition / 64] >> (bitPosition % 64)) & 1) == 0) {
+                return false; // If any bit is 0, the key was not inserted
+            }
+        }
+        return true; // possibly in the set (could be a false positive)
+    }
+
+    // Estimates how many elements have been inserted, based on number of set bits
+    uint64_t approx_size() const {
+        return bloom_estimate_cardinality(bloom_count_bits(words_, wordCount_), numBits_, numberOfHashFunctions_);
+    }
+
+    // Getter for the number of bits
+    uint64_t num_bits() const { return numBits_; }
+
+    // Getter for the number of hash functions
+    unsigned int num_hash_functions() const { return numberOfHashFunctions_; }
+
+    // Getter for the bit layout stored in the file
+    BloomLayout layout() const { return layout_; }
+
+private:
+    MappedBloomFilter(MappedFile file, const BloomFileHeader& header)
+        : file_(std::move(file)),
+        words_(reinterpret_cast<const uint64_t*>(file_.data() + sizeof(BloomFileHeader))),
+        wordCount_(header.wordCount),
+        numBits_(header.numBits),
+        numberOfHashFunctions_(header.numberOfHashFunctions),
+        layout_(static_cast<BloomLayout>(header.layout)) {
+    }
+
+    MappedFile file_;                   // Owns the read-only mapping
+    const uint64_t* words_;             // Filter words inside the mapping
+    std::size_t wordCount_;
+    uint64_t numBits_;
+    unsigned int numberOfHashFunctions_;
+    BloomLayout layout_;
+    HashFunction hasher_;               // hash function functor
+};
+
+#endif  // MAPPED_BLOOM_FILTER_HPP
@@ -1,73 +1,276 @@
 #ifndef MATRIX_HPP
 #define MATRIX_HPP
 
+#include <algorithm>
 #include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
+#include <new>
+#include <numeric>
 #include <ostream>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
 
+// Tag for the constructors that leave the elements default-initialized, i.e. indeterminate for
+// trivial types such as int or double: use when every element is written before it is read
+struct uninitialized_t {
+    explicit uninitialized_t() = default;
+};
+inline constexpr uninitialized_t uninitialized{};
+
+// Row layout of a Matrix
+// Packed: rows follow each other directly (stride == ncols), the data is one contiguous block
+// Padded: the stride is rounded up so that every row starts on a 64-byte boundary
+enum class MatrixLayout { Packed, Padded };
+
+// Lazily evaluated elementwise expression over matrices (built by the operators in
+// matrix_expression.hpp). row(r)[c] yields element (r, c) without materializing the matrix
+template <class Expression>
+concept MatrixExpression = requires(const Expression& expression, std::size_t index) {
+    typename Expression::is_matrix_expression;
+    typename Expression::value_type;
+    { expression.nrows() } -> std::convertible_to<std::size_t>;
+    { expression.ncols() } -> std::convertible_to<std::size_t>;
+    expression.row(index)[index];
+};
+
+// StridedIterator class template
+// Random-access iterator over elements `stride` apart in memory (a matrix column, a diagonal, or a
+// column walked upward with a negative stride). It keeps the start and an element index, so no
+// pointer outside the range is ever formed, and satisfies std::random_access_iterator
+// T: element type, const-qualified for read-only iteration
+template <class T>
+class StridedIterator {
+public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    StridedIterator() = default;
+
+    StridedIterator(T* origin, difference_type position, difference_type stride) noexcept
+        : origin_(origin), position_(position), stride_(stride) {
+    }
+
+    // Conversion from the mutable iterator to the const one
+    template <class U>
+        requires std::same_as<const U, T> && (!std::same_as<U, T>)
+    StridedIterator(const StridedIterator<U>& other) noexcept
+        : origin_(other.origin_), position_(other.position_), stride_(other.stride_) {
+    }
+
+    reference operator*() const noexcept { return origin_[position_ * stride_]; }
+    pointer operator->() const noexcept { return &**this; }
+    reference operator[](difference_type offset) const noexcept { return origin_[(position_ + offset) * stride_]; }
+
+    StridedIterator& operator++() noexcept { ++position_; return *this; }
+    StridedIterator operator++(int) noexcept { StridedIterator tmp = *this; ++position_; return tmp; }
+    StridedIterator& operator--() noexcept { --position_; return *this; }
+    StridedIterator operator--(int) noexcept { StridedIterator tmp = *this; --position_; return tmp; }
+    StridedIterator& operator+=(difference_type offset) noexcept { position_ += offset; return *this; }
+    StridedIterator& operator-=(difference_type offset) noexcept { position_ -= offset; return *this; }
+
+    friend StridedIterator operator+(StridedIterator it, difference_type offset) noexcept { return it += offset; }
+    friend StridedIterator operator+(difference_type offset, StridedIterator it) noexcept { return it += offset; }
+    friend StridedIterator operator-(StridedIterator it, difference_type offset) noexcept { return it -= offset; }
+
+    // Iterators are only compared and subtracted within one range
+    friend difference_type operator-(const StridedIterator& a, const StridedIterator& b) noexcept {
+        return a.position_ - b.position_;
+    }
+
+    friend bool operator==(const StridedIterator& a, const StridedIterator& b) noexcept {
+        return a.position_ == b.position_;
+    }
+
+    friend std::strong_ordering operator<=>(const StridedIterator& a, const StridedIterator& b) noexcept {
+        return a.position_ <=> b.position_;
+    }
+
+private:
+    template <class>
+    friend class StridedIterator;
+
+    T* origin_ = nullptr;           // first element of the range
+    difference_type position_ = 0;  // index of the current element
+    difference_type stride_ = 0;    // distance in elements between neighbours (may be negative)
+};
+
+// StridedView class template
+// Non-owning range of `size` elements `stride` apart; a std::ranges::random_access_range and
+// sized_range, so std::ranges algorithms (sort, max_element, ...) run on matrix columns and diagonals
+template <class T>
+class StridedView : public std::ranges::view_interface<StridedView<T>> {
+public:
+    StridedView() = default;
+
+    StridedView(T* origin, std::size_t size, std::ptrdiff_t stride) noexcept
+        : origin_(origin), size_(size), stride_(stride) {
+    }
+
+    // Conversion from the mutable view to the const one
+    operator StridedView<const T>() const noexcept requires (!std::is_const_v<T>) {
+        return {origin_, size_, stride_};
+    }
+
+    StridedIterator<T> begin() const noexcept { return {origin_, 0, stride_}; }
+    StridedIterator<T> end() const noexcept { return {origin_, static_cast<std::ptrdiff_t>(size_), stride_}; }
+
+    std::size_t size() const noexcept { return size_; }
+    std::ptrdiff_t stride() const noexcept { return stride_; }
+
+private:
+    T* origin_ = nullptr;
+    std::size_t size_ = 0;
+    std::ptrdiff_t stride_ = 0;
+};
+
+// Like std::span, a StridedView only refers to the matrix, so iterators taken from a temporary
+// view stay valid: std::ranges::max_element(m.column(0)) returns a usable iterator, not dangling
+template <class T>
+inline constexpr bool std::ranges::enable_borrowed_range<StridedView<T>> = true;
+
+static_assert(std::ranges::random_access_range<StridedView<int>>);
+static_assert(std::ranges::sized_range<StridedView<int>>);
+static_assert(std::ranges::view<StridedView<int>>);
+static_assert(std::ranges::borrowed_range<StridedView<int>>);
+static_assert(std::ranges::borrowed_range<StridedView<const int>>);
+
+// MatrixBlock class template
+// Non-owning rows x columns window into a matrix (see Matrix::block). Like std::span it does not
+// propagate const: use MatrixBlock<const T> for read-only access. A block is also an operand for
+// the expression templates of matrix_expression.hpp (Matrix<int> copy = m.block(0, 0, 2, 2))
+template <class T>
+class MatrixBlock {
+public:
+    using value_type = std::remove_const_t<T>;
+    using is_matrix_expression = void;
+
+    MatrixBlock(T* origin, std::size_t rowCount, std::size_t columnCount, std::size_t stride)
+        : origin_(origin), rowCount_(rowCount), columnCount_(columnCount), stride_(stride) {
+    }
+
+    // Conversion from the mutable block to the const one
+    operator MatrixBlock<const T>() const requires (!std::is_const_v<T>) {
+        return {origin_, rowCount_, columnCount_, stride_};
+    }
+
+    T& operator()(std::size_t rowIndex, std::size_t columnIndex) const {
+        assert(rowIndex < rowCount_ && columnIndex < columnCount_);
+        return origin_[rowIndex * stride_ + columnIndex];
+    }
+
+    std::span<T> row(std::size_t rowIndex) const {
+        assert(rowIndex < rowCount_);
+        return {origin_ + rowIndex * stride_, columnCount_};
+    }
+
+    StridedView<T> column(std::size_t columnIndex) const {
+        assert(columnIndex < columnCount_);
+        return {origin_ + columnIndex, rowCount_, static_cast<std::ptrdiff_t>(stride_)};
+    }
+
+    std::size_t nrows() const { return rowCount_; }
+    std::size_t ncols() const { return columnCount_; }
+    std::size_t stride() const { return stride_; }
+
+private:
+    T* origin_;
+    std::size_t rowCount_;
+    std::size_t columnCount_;
+    std::size_t stride_;
+};
+
+// Matrix class template
+// Row-major storage in one 64-byte-aligned buffer; element (r, c) lives at data()[r * stride() + c].
+// Copies are deep, moves only transfer the buffer and leave the source as an empty 0 x 0 matrix.
+// Rows, columns, diagonals and blocks are available as non-owning views over the buffer
 template <class ElementType>
 class Matrix {
 public:
+    // Thrown when matrix construction is invalid
     class Invalid {};
 
+    // Alignment of the buffer, and of every row in the Padded layout
+    static constexpr std::size_t alignment = 64;
+
     // Constructor: Create a matrix with all values initialized to default T()
-    Matrix(std::size_t numberOfRows, std::size_t numberOfColumns)
-        : Matrix(numberOfRows, numberOfColumns, ElementType()) {
+    Matrix(std::size_t numberOfRows, std::size_t numberOfColumns, MatrixLayout layout = MatrixLayout::Packed)
+        : Matrix(numberOfRows, numberOfColumns, ElementType(), layout) {
     }
 
     // Constructor: Create a matrix with all values set to a specified value
-    Matrix(std::size_t numberOfRows, std::size_t numberOfColumns, ElementType initialValue)
-        : totalRows_(numberOfRows),
-        totalColumns_(numberOfColumns),
-        rawData_(std::make_unique<ElementType[]>(numberOfRows* numberOfColumns)) {
+    Matrix(std::size_t numberOfRows, std::size_t numberOfColumns, const ElementType& initialValue,
+        MatrixLayout layout = MatrixLayout::Packed)
+        : Matrix(numberOfRows, numberOfColumns, layout, Allocation{}) {
 
-        if (numberOfRows == 0 || numberOfColumns == 0) {
-            throw Invalid{};  // Invalid if any dimension is zero
-        }
+        // Padding elements get the value too, so every element of the buffer is constructed
+        std::uninitialized_fill_n(rawData_.get(), allocatedElements(), initialValue);
+        rawData_.get_deleter().constructedElements = allocatedElements();
+    }
 
-        // Fill the entire matrix with the initial value
-        for (std::size_t linearIndex = 0, totalElements = numberOfRows * numberOfColumns;
-            linearIndex < totalElements; ++linearIndex) {
-            rawData_[linearIndex] = initialValue;
-        }
+    // Constructor: Create a matrix without initializing the values (see uninitialized_t)
+    Matrix(std::size_t numberOfRows, std::size_t numberOfColumns, uninitialized_t,
+        MatrixLayout layout = MatrixLayout::Packed)
+        : Matrix(numberOfRows, numberOfColumns, layout, Allocation{}) {
+
+        std::uninitialized_default_construct_n(rawData_.get(), allocatedElements());
+        rawData_.get_deleter().constructedElements = allocatedElements();
     }
 
     // Constructor: Create matrix from a 2D initializer list
     Matrix(std::initializer_list<std::initializer_list<ElementType>> initElements)
-        : totalRows_(initElements.size()), totalColumns_(0), rawData_() {
-
-        if (initElements.size() == 0 || initElements.begin()->size() == 0) {
-            throw Invalid{}; // Empty initializer list not allowed
-        }
-
-        totalColumns_ = initElements.begin()->size();
-        rawData_ = std::make_unique<ElementType[]>(totalRows_ * totalColumns_);
+        : Matrix(initElements.size(), initElements.size() == 0 ? 0 : initElements.begin()->size(),
+            MatrixLayout::Packed, Allocation{}) {
 
-        std::size_t linearIndex = 0;
         for (auto rowList : initElements) {
             // the number of columns must be the same for each row
             if (rowList.size() != totalColumns_) {
                 throw Invalid{};  // All rows must have the same number of columns
             }
-
-            for (auto value : rowList) {
-                rawData_[linearIndex] = value; // Flatten and store values row by row
-                ++linearIndex;
-            }
         }
+        // Flatten and store values row by row
+        ElementType* destination = rawData_.get();
+        for (auto rowList : initElements) {
+            destination = std::uninitialized_copy(rowList.begin(), rowList.end(), destination);
+            rawData_.get_deleter().constructedElements += rowList.size();
+        }
+    }
+
+    // Constructor: Evaluate an expression such as B + 2 * C into a new (packed) matrix
+    template <MatrixExpression Expression>
+        requires std::convertible_to<typename Expression::value_type, ElementType>
+    Matrix(const Expression& expression)
+        : Matrix(expression.nrows(), expression.ncols(), uninitialized) {
+        assign_rows(expression);
     }
 
-    // Copy constructor: Create a deep copy of another matrix
+    // Copy constructor: Create a deep copy of another matrix, with the same layout
     Matrix(const Matrix& originalMatrix)
-        : totalRows_(originalMatrix.nrows()),
-        totalColumns_(originalMatrix.ncols()),
-        rawData_() {
+        : totalRows_(originalMatrix.totalRows_),
+        totalColumns_(originalMatrix.totalColumns_),
+        columnStride_(originalMatrix.columnStride_),
+        rawData_(allocate(originalMatrix.allocatedElements())) {
 
-        rawData_ = std::make_unique<ElementType[]>(totalRows_ * totalColumns_);
-        std::copy(originalMatrix.rawData_.get(),
-            originalMatrix.rawData_.get() + (totalRows_ * totalColumns_),
-            rawData_.get());
+        std::uninitialized_copy_n(originalMatrix.rawData_.get(), allocatedElements(), rawData_.get());
+        rawData_.get_deleter().constructedElements = allocatedElements();
+    }
+
+    // Move constructor: Take over the buffer; the source becomes an empty 0 x 0 matrix
+    Matrix(Matrix&& sourceMatrix) noexcept
+        : totalRows_(std::exchange(sourceMatrix.totalRows_, 0)),
+        totalColumns_(std::exchange(sourceMatrix.totalColumns_, 0)),
+        columnStride_(std::exchange(sourceMatrix.columnStride_, 0)),
+        rawData_(std::move(sourceMatrix.rawData_)) {
     }
 
     // Copy assignment operator: Properly handle assignment, including self-assignment
@@ -76,45 +279,252 @@ public:
             return *this; // Do nothing if assigning to self
         }
 
-        // Allocate new space if current space is too small
-        if (totalRows_ * totalColumns_ < sourceMatrix.nrows() * sourceMatrix.ncols()) {
-            rawData_ = std::make_unique<ElementType[]>(sourceMatrix.nrows() * sourceMatrix.ncols());
+        // Same shape and layout: copy in place, otherwise build the copy first (strong guarantee)
+        if (totalRows_ == sourceMatrix.totalRows_ && totalColumns_ == sourceMatrix.totalColumns_ &&
+            columnStride_ == sourceMatrix.columnStride_) {
+            std::copy_n(sourceMatrix.rawData_.get(), allocatedElements(), rawData_.get());
         }
+        else {
+            *this = Matrix(sourceMatrix);
+        }
+        return *this;
+    }
 
-        totalRows_ = sourceMatrix.nrows();
-        totalColumns_ = sourceMatrix.ncols();
-
-        std::copy(sourceMatrix.rawData_.get(),
-            sourceMatrix.rawData_.get() + (totalRows_ * totalColumns_),
-            rawData_.get());
+    // Move assignment operator: Take over the buffer; the source becomes an empty 0 x 0 matrix
+    Matrix& operator=(Matrix&& sourceMatrix) noexcept {
+        if (this != &sourceMatrix) {
+            totalRows_ = std::exchange(sourceMatrix.totalRows_, 0);
+            totalColumns_ = std::exchange(sourceMatrix.totalColumns_, 0);
+            columnStride_ = std::exchange(sourceMatrix.columnStride_, 0);
+            rawData_ = std::move(sourceMatrix.rawData_);
+        }
+        return *this;
+    }
 
+    // Expression assignment: A = B + 2 * C runs as one loop over A's rows, without temporaries.
+    // The expression may refer to this matrix (A = A - B): every element only reads its own position
+    template <MatrixExpression Expression>
+        requires std::convertible_to<typename Expression::value_type, ElementType>
+    Matrix& operator=(const Expression& expression) {
+        if (totalRows_ == expression.nrows() && totalColumns_ == expression.ncols()) {
+            assign_rows(expression);
+        }
+        else {
+            *this = Matrix(expression);
+        }
         return *this;
     }
 
-    // Element access using matrix-style indexing 
+    // Sets every element to `value`
+    void fill(const ElementType& value) {
+        std::fill_n(rawData_.get(), allocatedElements(), value);
+    }
+
+    // Element access using matrix-style indexing
     ElementType& operator()(std::size_t rowIndex, std::size_t columnIndex) {
-        assert(rowIndex * totalColumns_ + columnIndex < totalRows_ * totalColumns_);
-        return rawData_[rowIndex * totalColumns_ + columnIndex];
+        assert(rowIndex < totalRows_ && columnIndex < totalColumns_);
+        return rawData_[rowIndex * columnStride_ + columnIndex];
     }
 
-    ElementType operator()(std::size_t rowIndex, std::size_t columnIndex) const {
-        assert(rowIndex * totalColumns_ + columnIndex < totalRows_ * totalColumns_);
-        return rawData_[rowIndex * totalColumns_ + columnIndex];
+    const ElementType& operator()(std::size_t rowIndex, std::size_t columnIndex) const {
+        assert(rowIndex < totalRows_ && columnIndex < totalColumns_);
+        return rawData_[rowIndex * columnStride_ + columnIndex];
     }
 
+    // Start of the buffer; row r starts at data() + r * stride()
+    ElementType* data() { return rawData_.get(); }
+    const ElementType* data() const { return rawData_.get(); }
+
     // Getter for number of rows
     std::size_t nrows() const { return totalRows_; }
 
     // Getter for number of columns
     std::size_t ncols() const { return totalColumns_; }
 
+    // Distance in elements between the starts of two consecutive rows (>= ncols())
+    std::size_t stride() const { return columnStride_; }
+
+    // Non-owning views; they stay valid as long as the matrix is neither moved from nor destroyed
+    // Row: contiguous
+    std::span<ElementType> row(std::size_t rowIndex) {
+        assert(rowIndex < totalRows_);
+        return {rawData_.get() + rowIndex * columnStride_, totalColumns_};
+    }
+
+    std::span<const ElementType> row(std::size_t rowIndex) const {
+        assert(rowIndex < totalRows_);
+        return {rawData_.get() + rowIndex * columnStride_, totalColumns_};
+    }
+
+    // Column: top to bottom, stride() apart
+    StridedView<ElementType> column(std::size_t columnIndex) {
+        assert(columnIndex < totalColumns_);
+        return {rawData_.get() + columnIndex, totalRows_, signed_stride()};
+    }
+
+    StridedView<const ElementType> column(std::size_t columnIndex) const {
+        assert(columnIndex < totalColumns_);
+        return {rawData_.get() + columnIndex, totalRows_, signed_stride()};
+    }
+
+    // Main diagonal (0, 0), (1, 1), ...; min(nrows, ncols) elements
+    StridedView<ElementType> diagonal() {
+        return {rawData_.get(), std::min(totalRows_, totalColumns_), signed_stride() + 1};
+    }
+
+    StridedView<const ElementType> diagonal() const {
+        return {rawData_.get(), std::min(totalRows_, totalColumns_), signed_stride() + 1};
+    }
+
+    // Anti-diagonal (0, ncols - 1), (1, ncols - 2), ...; min(nrows, ncols) elements
+    StridedView<ElementType> anti_diagonal() {
+        return {rawData_.get() + (totalColumns_ - 1), std::min(totalRows_, totalColumns_), signed_stride() - 1};
+    }
+
+    StridedView<const ElementType> anti_diagonal() const {
+        return {rawData_.get() + (totalColumns_ - 1), std::min(totalRows_, totalColumns_), signed_stride() - 1};
+    }
+
+    // Block of blockRows x blockColumns elements whose top-left corner is (firstRow, firstColumn)
+    MatrixBlock<ElementType> block(std::size_t firstRow, std::size_t firstColumn,
+        std::size_t blockRows, std::size_t blockColumns) {
+        assert(firstRow + blockRows <= totalRows_ && firstColumn + blockColumns <= totalColumns_);
+        return {rawData_.get() + firstRow * columnStride_ + firstColumn, blockRows, blockColumns, columnStride_};
+    }
+
+    MatrixBlock<const ElementType> block(std::size_t firstRow, std::size_t firstColumn,
+        std::size_t blockRows, std::size_t blockColumns) const {
+        assert(firstRow + blockRows <= totalRows_ && firstColumn + blockColumns <= totalColumns_);
+        return {rawData_.get() + firstRow * columnStride_ + firstColumn, blockRows, blockColumns, columnStride_};
+    }
+
+    // Column reverse iterator: goes upward in a column (a column walked with negative stride)
+    using ColReverseIt = StridedIterator<ElementType>;
+    using ConstColReverseIt = StridedIterator<const ElementType>;
+
+    // Diagonal iterator
+    using DiagIt = StridedIterator<ElementType>;
+    using ConstDiagIt = StridedIterator<const ElementType>;
+
+    using col_reverse_iterator = ColReverseIt;
+    using const_col_reverse_iterator = ConstColReverseIt;
+    using diag_iterator = DiagIt;
+    using const_diag_iterator = ConstDiagIt;
+
+    // Start and end of column in reverse (from bottom to before top)
+    col_reverse_iterator col_rbegin(std::size_t col) {
+        return reversed_column(col).begin();
+    }
+
+    col_reverse_iterator col_rend(std::size_t col) {
+        return reversed_column(col).end();
+    }
+
+    const_col_reverse_iterator col_rbegin(std::size_t col) const {
+        return reversed_column(col).begin();
+    }
+
+    const_col_reverse_iterator col_rend(std::size_t col) const {
+        return reversed_column(col).end();
+    }
+
+    // Diagonal iterator (for square matrix)
+    diag_iterator diag_begin() {
+        assert(totalRows_ == totalColumns_);
+        return diagonal().begin();
+    }
+
+    diag_iterator diag_end() {
+        assert(totalRows_ == totalColumns_);
+        return diagonal().end();
+    }
+
+    const_diag_iterator diag_begin() const {
+        assert(totalRows_ == totalColumns_);
+        return diagonal().begin();
+    }
+
+    const_diag_iterator diag_end() const {
+        assert(totalRows_ == totalColumns_);
+        return diagonal().end();
+    }
+
 private:
+    // Column from the bottom row up
+    StridedView<ElementType> reversed_column(std::size_t columnIndex) {
+        assert(columnIndex < totalColumns_);
+        return {rawData_.get() + (totalRows_ - 1) * columnStride_ + columnIndex, totalRows_, -signed_stride()};
+    }
+
+    StridedView<const ElementType> reversed_column(std::size_t columnIndex) const {
+        assert(columnIndex < totalColumns_);
+        return {rawData_.get() + (totalRows_ - 1) * columnStride_ + columnIndex, totalRows_, -signed_stride()};
+    }
+
+    std::ptrdiff_t signed_stride() const { return static_cast<std::ptrdiff_t>(columnStride_); }
+
+    // Destroys the elements constructed so far and returns the aligned buffer
+    struct AlignedDelete {
+        std::size_t constructedElements = 0;
+
+        void operator()(ElementType* buffer) const noexcept {
+            std::destroy_n(buffer, constructedElements);
+            ::operator delete(buffer, std::align_val_t{alignment});
+        }
+    };
+
+    using Buffer = std::unique_ptr<ElementType[], AlignedDelete>;
+
+    // Tag for the delegating constructor that only allocates
+    struct Allocation {};
+
+    // Constructor: Validate the shape and allocate the buffer; the caller constructs the elements
+    Matrix(std::size_t numberOfRows, std::size_t numberOfColumns, MatrixLayout layout, Allocation)
+        : totalRows_(numberOfRows),
+        totalColumns_(numberOfColumns),
+        columnStride_(layout == MatrixLayout::Padded ? padded_stride(numberOfColumns) : numberOfColumns),
+        rawData_() {
+
+        if (numberOfRows == 0 || numberOfColumns == 0) {
+            throw Invalid{};  // Invalid if any dimension is zero
+        }
+        rawData_ = allocate(allocatedElements());
+    }
+
+    // Writes the expression row by row; the inner loop is a plain indexed loop the compiler can vectorize
+    template <MatrixExpression Expression>
+    void assign_rows(const Expression& expression) {
+        for (std::size_t rowIndex = 0; rowIndex < totalRows_; ++rowIndex) {
+            ElementType* destination = rawData_.get() + rowIndex * columnStride_;
+            const auto source = expression.row(rowIndex);
+            for (std::size_t columnIndex = 0; columnIndex < totalColumns_; ++columnIndex) {
+                destination[columnIndex] = static_cast<ElementType>(source[columnIndex]);
+            }
+        }
+    }
+
+    // Smallest stride >= columns whose rows all start on an alignment boundary
+    static std::size_t padded_stride(std::size_t numberOfColumns) {
+        std::size_t elementsPerBoundary = alignment / std::gcd(alignment, sizeof(ElementType));
+        return (numberOfColumns + elementsPerBoundary - 1) / elementsPerBoundary * elementsPerBoundary;
+    }
+
+    static Buffer allocate(std::size_t elementCount) {
+        void* memory = ::operator new(elementCount * sizeof(ElementType), std::align_val_t{alignment});
+        return Buffer(static_cast<ElementType*>(memory));
+    }
+
+    // Elements in the buffer, padding included
+    std::size_t allocatedElements() const { return totalRows_ * columnStride_; }
+
     std::size_t totalRows_;
     std::size_t totalColumns_;
-    std::unique_ptr<ElementType[]> rawData_;  // Raw matrix data stored in 1D array
+    std::size_t columnStride_;  // elements from one row start to the next
+    Buffer rawData_;            // Raw matrix data stored in 1D array, row-major with stride columnStride_
 };
 
 // Overloaded output operator to print matrix in a clean row-wise format
+// Elements are separated by one space and every row, the last one included, ends with '\n'
 template <typename ElementType>
 std::ostream& operator<<(std::ostream& os, const Matrix<ElementType>& matrix) {
     for (std::size_t rowIndex = 0; rowIndex < matrix.nrows(); ++rowIndex) {
@@ -0,0 +1,353 @@
+#ifndef MATRIX_EXPRESSION_HPP
+#define MATRIX_EXPRESSION_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "matrix.hpp"
+
+// Lazy elementwise arithmetic on Matrix
+// The operators below build small expression objects instead of matrices: B + 2 * C is a tree that
+// refers to B and C, and assigning it to a Matrix (or constructing one from it) evaluates every
+// element in a single loop, without intermediate matrices. Operands:
+// - matrices (or MatrixBlock views) of the same shape and element type; a shape mismatch throws
+//   Matrix<T>::Invalid
+// - scalars on either side of + - * that convert to the element type without narrowing (or integer
+//   scalars for floating-point elements); Matrix<int> A = B + 0.5 * C does not compile
+// Expressions refer to their matrices, so they must not outlive them (do not keep an expression
+// built from a temporary Matrix in an `auto` variable).
+// Reductions (sum, min_value, max_value, row_min, col_min) take a Matrix or an expression.
+
+namespace matrix_detail {
+
+// Leaf: one Matrix, read through its row pointers
+template <class T>
+class MatrixReference {
+public:
+    using value_type = T;
+    using is_matrix_expression = void;
+
+    explicit MatrixReference(const Matrix<T>& matrix)
+        : data_(matrix.data()), stride_(matrix.stride()), rowCount_(matrix.nrows()), columnCount_(matrix.ncols()) {
+    }
+
+    std::size_t nrows() const { return rowCount_; }
+    std::size_t ncols() const { return columnCount_; }
+    const T* row(std::size_t rowIndex) const { return data_ + rowIndex * stride_; }
+
+private:
+    const T* data_;
+    std::size_t stride_;
+    std::size_t rowCount_;
+    std::size_t columnCount_;
+};
+
+// Leaf: the same value at every position; takes its shape from the other operand
+template <class T>
+class ScalarOperand {
+public:
+    using value_type = T;
+
+    struct Row {
+        T value;
+        T operator[](std::size_t) const { return value; }
+    };
+
+    explicit ScalarOperand(T value) : value_(value) {}
+
+    Row row(std::size_t) const { return Row{value_}; }
+
+private:
+    T value_;
+};
+
+// Node: Operation applied to the elements of two operands at the same position
+template <class Operation, class Left, class Right>
+class BinaryExpression {
+public:
+    using value_type = typename Left::value_type;
+    using is_matrix_expression = void;
+
+    struct Row {
+        decltype(std::declval<const Left&>().row(0)) left;
+        decltype(std::declval<const Right&>().row(0)) right;
+
+        value_type operator[](std::size_t columnIndex) const {
+            return static_cast<value_type>(Operation{}(left[columnIndex], right[columnIndex]));
+        }
+    };
+
+    BinaryExpression(Left left, Right right, std::size_t rowCount, std::size_t columnCount)
+        : left_(std::move(left)), right_(std::move(right)), rowCount_(rowCount), columnCount_(columnCount) {
+    }
+
+    std::size_t nrows() const { return rowCount_; }
+    std::size_t ncols() const { return columnCount_; }
+    Row row(std::size_t rowIndex) const { return Row{left_.row(rowIndex), right_.row(rowIndex)}; }
+
+private:
+    Left left_;
+    Right right_;
+    std::size_t rowCount_;
+    std::size_t columnCount_;
+};
+
+// Node: Operation applied to every element of one operand
+template <class Operation, class Operand>
+class UnaryExpression {
+public:
+    using value_type = typename Operand::value_type;
+    using is_matrix_expression = void;
+
+    struct Row {
+        decltype(std::declval<const Operand&>().row(0)) operand;
+
+        value_type operator[](std::size_t columnIndex) const {
+            return static_cast<value_type>(Operation{}(operand[columnIndex]));
+        }
+    };
+
+    explicit UnaryExpression(Operand operand) : operand_(std::move(operand)) {}
+
+    std::size_t nrows() const { return operand_.nrows(); }
+    std::size_t ncols() const { return operand_.ncols(); }
+    Row row(std::size_t rowIndex) const { return Row{operand_.row(rowIndex)}; }
+
+private:
+    Operand operand_;
+};
+
+// Elementwise minimum / maximum, written as selects so the loops stay vectorizable
+struct Minimum {
+    template <class T>
+    T operator()(const T& left, const T& right) const { return right < left ? right : left; }
+};
+
+struct Maximum {
+    template <class T>
+    T operator()(const T& left, const T& right) const { return left < right ? right : left; }
+};
+
+template <class T>
+inline constexpr bool isMatrix = false;
+
+template <class T>
+inline constexpr bool isMatrix<Matrix<T>> = true;
+
+// A Matrix or an expression over matrices
+template <class Operand>
+concept MatrixOperand = isMatrix<Operand> || MatrixExpression<Operand>;
+
+// Matrices enter expressions by reference, expressions by value
+template <class T>
+MatrixReference<T> as_expression(const Matrix<T>& matrix) {
+    return MatrixReference<T>(matrix);
+}
+
+template <MatrixExpression Expression>
+const Expression& as_expression(const Expression& expression) {
+    return expression;
+}
+
+template <class Operand>
+using ExpressionOf = std::remove_cvref_t<decltype(as_expression(std::declval<const Operand&>()))>;
+
+template <class Operand>
+using ValueOf = typename ExpressionOf<Operand>::value_type;
+
+// A scalar that can be combined with the elements of Operand without losing its value: the
+// conversion must not narrow (0.5 * intMatrix is rejected instead of silently becoming 0 * intMatrix),
+// except that integer scalars are accepted for floating-point elements (2 * doubleMatrix)
+template <class Scalar, class Operand>
+concept ScalarFor = !MatrixOperand<Scalar> &&
+    (requires { ValueOf<Operand>{std::declval<const Scalar&>()}; } ||
+        (std::integral<Scalar> && std::floating_point<ValueOf<Operand>>));
+
+template <class Operation, MatrixOperand Left, MatrixOperand Right>
+    requires std::same_as<ValueOf<Left>, ValueOf<Right>>
+auto combine(const Left& left, const Right& right) {
+    if (left.nrows() != right.nrows() || left.ncols() != right.ncols()) {
+        throw typename Matrix<ValueOf<Left>>::Invalid{};
+    }
+    return BinaryExpression<Operation, ExpressionOf<Left>, ExpressionOf<Right>>(
+        as_expression(left), as_expression(right), left.nrows(), left.ncols());
+}
+
+template <class Operation, MatrixOperand Left, class Scalar>
+auto combine_scalar_right(const Left& left, const Scalar& scalar) {
+    using T = ValueOf<Left>;
+    return BinaryExpression<Operation, ExpressionOf<Left>, ScalarOperand<T>>(
+        as_expression(left), ScalarOperand<T>(static_cast<T>(scalar)), left.nrows(), left.ncols());
+}
+
+template <class Operation, class Scalar, MatrixOperand Right>
+auto combine_scalar_left(const Scalar& scalar, const Right& right) {
+    using T = ValueOf<Right>;
+    return BinaryExpression<Operation, ScalarOperand<T>, ExpressionOf<Right>>(
+        ScalarOperand<T>(static_cast<T>(scalar)), as_expression(right), right.nrows(), right.ncols());
+}
+
+} // namespace matrix_detail
+
+// Elementwise A + B, A + s, s + A
+template <matrix_detail::MatrixOperand Left, matrix_detail::MatrixOperand Right>
+auto operator+(const Left& left, const Right& right) {
+    return matrix_detail::combine<std::plus<>>(left, right);
+}
+
+template <matrix_detail::MatrixOperand Left, matrix_detail::ScalarFor<Left> Scalar>
+auto operator+(const Left& left, const Scalar& scalar) {
+    return matrix_detail::combine_scalar_right<std::plus<>>(left, scalar);
+}
+
+template <matrix_detail::MatrixOperand Right, matrix_detail::ScalarFor<Right> Scalar>
+auto operator+(const Scalar& scalar, const Right& right) {
+    return matrix_detail::combine_scalar_left<std::plus<>>(scalar, right);
+}
+
+// Elementwise A - B, A - s, s - A
+template <matrix_detail::MatrixOperand Left, matrix_detail::MatrixOperand Right>
+auto operator-(const Left& left, const Right& right) {
+    return matrix_detail::combine<std::minus<>>(left, right);
+}
+
+template <matrix_detail::MatrixOperand Left, matrix_detail::ScalarFor<Left> Scalar>
+auto operator-(const Left& left, const Scalar& scalar) {
+    return matrix_detail::combine_scalar_right<std::minus<>>(left, scalar);
+}
+
+template <matrix_detail::MatrixOperand Right, matrix_detail::ScalarFor<Right> Scalar>
+auto operator-(const Scalar& scalar, const Right& right) {
+    return matrix_detail::combine_scalar_left<std::minus<>>(scalar, right);
+}
+
+// Elementwise (Hadamard) A * B, and A * s, s * A
+template <matrix_detail::MatrixOperand Left, matrix_detail::MatrixOperand Right>
+auto operator*(const Left& left, const Right& right) {
+    return matrix_detail::combine<std::multiplies<>>(left, right);
+}
+
+template <matrix_detail::MatrixOperand Left, matrix_detail::ScalarFor<Left> Scalar>
+auto operator*(const Left& left, const Scalar& scalar) {
+    return matrix_detail::combine_scalar_right<std::multiplies<>>(left, scalar);
+}
+
+template <matrix_detail::MatrixOperand Right, matrix_detail::ScalarFor<Right> Scalar>
+auto operator*(const Scalar& scalar, const Right& right) {
+    return matrix_detail::combine_scalar_left<std::multiplies<>>(scalar, right);
+}
+
+// Elementwise -A
+template <matrix_detail::MatrixOperand Operand>
+auto operator-(const Operand& operand) {
+    using Expression = matrix_detail::ExpressionOf<Operand>;
+    return matrix_detail::UnaryExpression<std::negate<>, Expression>(matrix_detail::as_expression(operand));
+}
+
+// Elementwise min(A, B), min(A, s)
+template <matrix_detail::MatrixOperand Left, matrix_detail::MatrixOperand Right>
+auto min(const Left& left, const Right& right) {
+    return matrix_detail::combine<matrix_detail::Minimum>(left, right);
+}
+
+template <matrix_detail::MatrixOperand Left, matrix_detail::ScalarFor<Left> Scalar>
+auto min(const Left& left, const Scalar& scalar) {
+    return matrix_detail::combine_scalar_right<matrix_detail::Minimum>(left, scalar);
+}
+
+// Elementwise max(A, B), max(A, s)
+template <matrix_detail::MatrixOperand Left, matrix_detail::MatrixOperand Right>
+auto max(const Left& left, const Right& right) {
+    return matrix_detail::combine<matrix_detail::Maximum>(left, right);
+}
+
+template <matrix_detail::MatrixOperand Left, matrix_detail::ScalarFor<Left> Scalar>
+auto max(const Left& left, const Scalar& scalar) {
+    return matrix_detail::combine_scalar_right<matrix_detail::Maximum>(left, scalar);
+}
+
+// Sum of all elements, accumulated in the element type
+template <matrix_detail::MatrixOperand Operand>
+matrix_detail::ValueOf<Operand> sum(const Operand& operand) {
+    const auto& expression = matrix_detail::as_expression(operand);
+    matrix_detail::ValueOf<Operand> total{};
+    for (std::size_t rowIndex = 0; rowIndex < expression.nrows(); ++rowIndex) {
+        const auto row = expression.row(rowIndex);
+        for (std::size_t columnIndex = 0; columnIndex < expression.ncols(); ++columnIndex) {
+            total += row[columnIndex];
+        }
+    }
+    return total;
+}
+
+// Minimum of each row (one entry per row)
+template <matrix_detail::MatrixOperand Operand>
+std::vector<matrix_detail::ValueOf<Operand>> row_min(const Operand& operand) {
+    const auto& expression = matrix_detail::as_expression(operand);
+    std::vector<matrix_detail::ValueOf<Operand>> minima;
+    minima.reserve(expression.nrows());
+    for (std::size_t rowIndex = 0; rowIndex < expression.nrows(); ++rowIndex) {
+        const auto row = expression.row(rowIndex);
+        matrix_detail::ValueOf<Operand> minimum = row[0];
+        for (std::size_t columnIndex = 1; columnIndex < expression.ncols(); ++columnIndex) {
+            minimum = matrix_detail::Minimum{}(minimum, row[columnIndex]);
+        }
+        minima.push_back(minimum);
+    }
+    return minima;
+}
+
+// Minimum of each column (one entry per column); walks the rows in order, so every pass is contiguous
+template <matrix_detail::MatrixOperand Operand>
+std::vector<matrix_detail::ValueOf<Operand>> col_min(const Operand& operand) {
+    const auto& expression = matrix_detail::as_expression(operand);
+    std::vector<matrix_detail::ValueOf<Operand>> minima;
+    if (expression.nrows() == 0) {
+        return minima;
+    }
+    const auto firstRow = expression.row(0);
+    minima.reserve(expression.ncols());
+    for (std::size_t columnIndex = 0; columnIndex < expression.ncols(); ++columnIndex) {
+        minima.push_back(firstRow[columnIndex]);
+    }
+    for (std::size_t rowIndex = 1; rowIndex < expression.nrows(); ++rowIndex) {
+        const auto row = expression.row(rowIndex);
+        for (std::size_t columnIndex = 0; columnIndex < expression.ncols(); ++columnIndex) {
+            minima[columnIndex] = matrix_detail::Minimum{}(minima[columnIndex], row[columnIndex]);
+        }
+    }
+    return minima;
+}
+
+// Smallest element; the matrix must not be empty
+template <matrix_detail::MatrixOperand Operand>
+matrix_detail::ValueOf<Operand> min_value(const Operand& operand) {
+    const auto& expression = matrix_detail::as_expression(operand);
+    matrix_detail::ValueOf<Operand> minimum = expression.row(0)[0];
+    for (std::size_t rowIndex = 0; rowIndex < expression.nrows(); ++rowIndex) {
+        const auto row = expression.row(rowIndex);
+        for (std::size_t columnIndex = 0; columnIndex < expression.ncols(); ++columnIndex) {
+            minimum = matrix_detail::Minimum{}(minimum, row[columnIndex]);
+        }
+    }
+    return minimum;
+}
+
+// Largest element; the matrix must not be empty
+template <matrix_detail::MatrixOperand Operand>
+matrix_detail::ValueOf<Operand> max_value(const Operand& operand) {
+    const auto& expression = matrix_detail::as_expression(operand);
+    matrix_detail::ValueOf<Operand> maximum = expression.row(0)[0];
+    for (std::size_t rowIndex = 0; rowIndex < expression.nrows(); ++rowIndex) {
+        const auto row = expression.row(rowIndex);
+        for (std::size_t columnIndex = 0; columnIndex < expression.ncols(); ++columnIndex) {
+            maximum = matrix_detail::Maximum{}(maximum, row[columnIndex]);
+        }
+    }
+    return maximum;
+}
+
+#endif  // MATRIX_EXPRESSION_HPP
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "matrix.hpp"
+#include "matrix_expression.hpp"
+
+// Fused expression templates vs. hand-written loops for A = B + c * C on an n x n double matrix:
+// - temporaries: c * C into a new matrix, then B + that into another new matrix (the style the
+//   expression templates replace)
+// - fused loop: one hand-written loop into the existing A (the lower bound)
+// - expression: A = B + c * C through matrix_expression.hpp
+// All three must produce the same matrix. A smaller integer matrix then checks -A, min / max
+// and the reductions against plain loops. Exits with status 1 on any mismatch.
+// usage: a4_matrix_expression_benchmark [n] [repetitions]
+
+namespace {
+
+// A scalar that would narrow must not combine with the elements (0.5 * intMatrix used to become 0)
+template <class Scalar, class Operand>
+concept Combines = requires(const Scalar& scalar, const Operand& operand) { scalar * operand; };
+
+static_assert(Combines<int, Matrix<int>>);
+static_assert(Combines<int, Matrix<double>>);
+static_assert(Combines<float, Matrix<double>>);
+static_assert(!Combines<double, Matrix<int>>);
+static_assert(!Combines<long long, Matrix<int>>);
+
+Matrix<double> scaled_sum_with_temporaries(const Matrix<double>& b, double c, const Matrix<double>& cMatrix) {
+    Matrix<double> scaled(cMatrix.nrows(), cMatrix.ncols());
+    for (std::size_t row = 0; row < cMatrix.nrows(); row++) {
+        for (std::size_t col = 0; col < cMatrix.ncols(); col++) {
+            scaled(row, col) = c * cMatrix(row, col);
+        }
+    }
+    Matrix<double> result(b.nrows(), b.ncols());
+    for (std::size_t row = 0; row < b.nrows(); row++) {
+        for (std::size_t col = 0; col < b.ncols(); col++) {
+            result(row, col) = b(row, col) + scaled(row, col);
+        }
+    }
+    return result;
+}
+
+void scaled_sum_fused(Matrix<double>& a, const Matrix<double>& b, double c, const Matrix<double>& cMatrix) {
+    for (std::size_t row = 0; row < a.nrows(); row++) {
+        double* target = a.data() + row * a.stride();
+        const double* left = b.data() + row * b.stride();
+        const double* right = cMatrix.data() + row * cMatrix.stride();
+        for (std::size_t col = 0; col < a.ncols(); col++) {
+            target[col] = left[col] + c * right[col];
+        }
+    }
+}
+
+template <class T>
+bool equal(const Matrix<T>& left, const Matrix<T>& right) {
+    if (left.nrows() != right.nrows() || left.ncols() != right.ncols()) {
+        return false;
+    }
+    for (std::size_t row = 0; row < left.nrows(); row++) {
+        for (std::size_t col = 0; col < left.ncols(); col++) {
+            if (left(row, col) != right(row, col)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename Run>
+double seconds_per_run(int repetitions, Run run) {
+    auto start = std::chrono::steady_clock::now();
+    for (int repetition = 0; repetition < repetitions; repetition++) {
+        run();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repetitions;
+}
+
+// -A, min / max and the reductions on an integer matrix, checked element by element
+bool check_integer_operations(std::mt19937& generator) {
+    std::uniform_int_distribution<int> values(-50, 50);
+    Matrix<int> b(37, 53);
+    Matrix<int> c(37, 53);
+    for (std::size_t row = 0; row < b.nrows(); row++) {
+        for (std::size_t col = 0; col < b.ncols(); col++) {
+            b(row, col) = values(generator);
+            c(row, col) = values(generator);
+        }
+    }
+
+    // One expression using every operator, against the same formula element by element
+    Matrix<int> a = max(min(b, c), -10) - 3 * c + (-b) * 2;
+    int expectedSum = 0;
+    int expectedMin = a(0, 0);
+    int expectedMax = a(0, 0);
+    std::vector<int> expectedRowMin(a.nrows(), a(0, 0));
+    std::vector<int> expectedColMin(a.ncols(), a(0, 0));
+    for (std::size_t row = 0; row < b.nrows(); row++) {
+        for (std::size_t col = 0; col < b.ncols(); col++) {
+            int smaller = std::min(b(row, col), c(row, col));
+            int expected = std::max(smaller, -10) - 3 * c(row, col) + -b(row, col) * 2;
+            if (a(row, col) != expected) {
+                return false;
+            }
+            expectedSum += expected;
+            expectedMin = std::min(expectedMin, expected);
+            expectedMax = std::max(expectedMax, expected);
+            expectedRowMin[row] = col == 0 ? expected : std::min(expectedRowMin[row], expected);
+            expectedColMin[col] = row == 0 ? expected : std::min(expectedColMin[col], expected);
+        }
+    }
+
+    // Reductions on a matrix and directly on an expression (a - a + 1 is all ones)
+    return sum(a) == expectedSum && min_value(a) == expectedMin && max_value(a) == expectedMax &&
+        row_min(a) == expectedRowMin && col_min(a) == expectedColMin &&
+        sum(a - a + 1) == static_cast<int>(a.nrows() * a.ncols());
+}
+
+} // namespace
+
+int main(int argc, const char* argv[]) {
+    std::size_t size = argc > 1 ? std::stoul(argv[1]) : 2000;
+    int repetitions = argc > 2 ? std::stoi(argv[2]) : 10;
+    const double c = 0.5;
+
+    std::mt19937 generator(2024);
+    std::uniform_real_distribution<double> values(-1.0, 1.0);
+    Matrix<double> b(size, size);
+    Matrix<double> cMatrix(size, size);
+    for (std::size_t row = 0; row < size; row++) {
+        for (std::size_t col = 0; col < size; col++) {
+            b(row, col) = values(generator);
+            cMatrix(row, col) = values(generator);
+        }
+    }
+
+    Matrix<double> withTemporaries(size, size);
+    Matrix<double> fused(size, size);
+    Matrix<double> expression(size, size);
+    double temporariesSeconds = seconds_per_run(repetitions,
+        [&] { withTemporaries = scaled_sum_with_temporaries(b, c, cMatrix); });
+    double fusedSeconds = seconds_per_run(repetitions, [&] { scaled_sum_fused(fused, b, c, cMatrix); });
+    double expressionSeconds = seconds_per_run(repetitions, [&] { expression = b + c * cMatrix; });
+
+    std::cout << "A = B + " << c << " * C, n = " << size << ", " << repetitions << " repetitions\n"
+        << std::setw(14) << "variant" << std::setw(14) << "time [s]" << std::setw(12) << "speedup" << '\n'
+        << std::fixed << std::setprecision(4)
+        << std::setw(14) << "temporaries" << std::setw(14) << temporariesSeconds << std::setw(12) << 1.0 << '\n'
+        << std::setw(14) << "fused loop" << std::setw(14) << fusedSeconds
+        << std::setw(12) << temporariesSeconds / fusedSeconds << '\n'
+        << std::setw(14) << "expression" << std::setw(14) << expressionSeconds
+        << std::setw(12) << temporariesSeconds / expressionSeconds << '\n';
+
+    if (!equal(expression, withTemporaries) || !equal(expression, fused)) {
+        std::cerr << "expression result differs from the hand-written loops\n";
+        return EXIT_FAILURE;
+    }
+    if (!check_integer_operations(generator)) {
+        std::cerr << "integer operators or reductions differ from the hand-written loops\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
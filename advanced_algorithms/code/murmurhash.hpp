@@ -1,7 +1,9 @@
 #ifndef MURMURHASH_HPP
 #define MURMURHASH_HPP
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 // implementation of mumurhash 3 from wikipedia
 // https://en.wikipedia.org/wiki/MurmurHash
@@ -14,17 +16,17 @@
 // This function takes a pointer to some raw data (`key`),
 // its length (`len`), and a seed value (`seed`).
 // It returns a 32-bit unsigned integer as the hash.
-uint32_t murmur3_32(const uint8_t* key, std::size_t len, uint32_t seed) {
+inline uint32_t murmur3_32(const uint8_t* key, std::size_t len, uint32_t seed) {
 
   uint32_t h = seed; // Initialize hash with the seed value
 
   // Process 4 bytes at a time
   if (len > 3) {
-      const uint32_t* blocks = reinterpret_cast<const uint32_t*>(key);
       std::size_t num_blocks = len / 4;
 
       for (std::size_t i = 0; i < num_blocks; ++i) {
-          uint32_t k = blocks[i];  // Read 4 bytes (one block)
+          uint32_t k;
+          std::memcpy(&k, key + i * 4, sizeof(k));  // Read 4 bytes (one block), any alignment
 
           // Mix the bits with constants to scramble them
           k *= 0xcc9e2d51;
@@ -69,4 +71,78 @@ uint32_t murmur3_32(const uint8_t* key, std::size_t len, uint32_t seed) {
   return h; // Return the final hash value
 }
 
+// Both 64-bit halves of a 128-bit hash
+struct Hash128 {
+  uint64_t h1;
+  uint64_t h2;
+};
+
+inline uint64_t rotl64(uint64_t x, int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+// 64-bit finalizer of murmurhash 3: every input bit affects every output bit
+inline uint64_t fmix64(uint64_t k) {
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+// murmurhash 3, x64 128-bit variant (MurmurHash3_x64_128 from the reference implementation)
+// One pass yields two independent 64-bit hashes.
+// Blocks are read with memcpy, so `key` needs no particular alignment.
+inline Hash128 murmur3_x64_128(const uint8_t* key, std::size_t len, uint32_t seed) {
+  const uint64_t c1 = 0x87c37b91114253d5ULL;
+  const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+  uint64_t h1 = seed;
+  uint64_t h2 = seed;
+
+  // Process 16 bytes at a time
+  const std::size_t num_blocks = len / 16;
+  for (std::size_t i = 0; i < num_blocks; ++i) {
+      uint64_t k1;
+      uint64_t k2;
+      std::memcpy(&k1, key + i * 16, sizeof(k1));
+      std::memcpy(&k2, key + i * 16 + 8, sizeof(k2));
+
+      k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+      h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+      k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+      h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+  }
+
+  // Process the remaining 0..15 bytes, little-endian
+  const uint8_t* tail = key + num_blocks * 16;
+  const std::size_t tail_len = len & 15;
+  uint64_t k1 = 0;
+  uint64_t k2 = 0;
+  for (std::size_t i = 0; i < tail_len; ++i) {
+      if (i < 8) k1 |= static_cast<uint64_t>(tail[i]) << (i * 8);
+      else       k2 |= static_cast<uint64_t>(tail[i]) << ((i - 8) * 8);
+  }
+  if (tail_len > 8) {
+      k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+  }
+  if (tail_len > 0) {
+      k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+  }
+
+  // Finalization
+  h1 ^= static_cast<uint64_t>(len);
+  h2 ^= static_cast<uint64_t>(len);
+  h1 += h2;
+  h2 += h1;
+  h1 = fmix64(h1);
+  h2 = fmix64(h2);
+  h1 += h2;
+  h2 += h1;
+
+  return Hash128{h1, h2};
+}
+
 #endif  // MURMURHASH_HPP
\ No newline at end of file
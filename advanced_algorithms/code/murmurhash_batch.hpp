@@ -0,0 +1,256 @@
+#ifndef MURMURHASH_BATCH_HPP
+#define MURMURHASH_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "murmurhash.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MURMUR3_BATCH_X86 1
+#include <immintrin.h>
+#else
+#define MURMUR3_BATCH_X86 0
+#endif
+
+// Batch form of murmur3_32: many keys of one width, each hashed with several seeds, per call
+//   out[key * seedCount + s] == murmur3_32(keys + key * keySize, keySize, seeds[s])
+// for every key < keyCount and s < seedCount, bit for bit.
+// The block mixing of a key does not depend on the seed, so it is done once per block and shared
+// by all seeds. On x86 (GCC / Clang) an AVX-512 kernel (16 keys per step) or an AVX2 kernel
+// (8 keys per step) is picked at run time; other targets and the leftover keys use murmur3_32.
+
+// Kernels murmur3_32_batch can run on
+enum class Murmur3Kernel { scalar = 0, avx2 = 1, avx512 = 2 };
+
+namespace murmur3_detail {
+
+// Length mixed into the finalisation: murmur3_32 reduces len to len % 4 once it has consumed
+// whole blocks, and the batch kernels must reproduce that exactly
+inline uint32_t final_length(std::size_t keySize) {
+  return static_cast<uint32_t>(keySize > 3 ? keySize & 3 : keySize);
+}
+
+// The 0..3 bytes after the last whole block, little-endian, mixed like a block
+// An empty tail mixes to 0, so it can always be XORed in
+inline uint32_t mixed_tail(const uint8_t* key, std::size_t keySize) {
+  const uint8_t* tail = key + (keySize & ~std::size_t{3});
+  uint32_t k = 0;
+  for (std::size_t i = 0; i < (keySize & 3); ++i) {
+      k |= static_cast<uint32_t>(tail[i]) << (i * 8);
+  }
+  k *= 0xcc9e2d51;
+  k = (k << 15) | (k >> 17);
+  k *= 0x1b873593;
+  return k;
+}
+
+inline void hash_scalar(const uint8_t* keys, std::size_t keySize, std::size_t firstKey, std::size_t keyCount,
+    const uint32_t* seeds, std::size_t seedCount, uint32_t* out) {
+  for (std::size_t key = firstKey; key < keyCount; ++key) {
+      for (std::size_t s = 0; s < seedCount; ++s) {
+          out[key * seedCount + s] = murmur3_32(keys + key * keySize, keySize, seeds[s]);
+      }
+  }
+}
+
+#if MURMUR3_BATCH_X86
+
+// Seeds are hashed in chunks of this many, so the running hashes stay in registers
+constexpr std::size_t seedsPerPass = 8;
+
+// Hashes keys [0, keyCount - keyCount % 8) eight at a time; returns the number of keys done
+__attribute__((target("avx2")))
+inline std::size_t hash_avx2(const uint8_t* keys, std::size_t keySize, std::size_t keyCount,
+    const uint32_t* seeds, std::size_t seedCount, uint32_t* out) {
+  const std::size_t numBlocks = keySize / 4;
+  const int stride = static_cast<int>(keySize);
+  const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+  const __m256i c1 = _mm256_set1_epi32(static_cast<int>(0xcc9e2d51u));
+  const __m256i c2 = _mm256_set1_epi32(static_cast<int>(0x1b873593u));
+  const __m256i c3 = _mm256_set1_epi32(static_cast<int>(0xe6546b64u));
+  const __m256i f1 = _mm256_set1_epi32(static_cast<int>(0x85ebca6bu));
+  const __m256i f2 = _mm256_set1_epi32(static_cast<int>(0xc2b2ae35u));
+  const __m256i length = _mm256_set1_epi32(static_cast<int>(final_length(keySize)));
+
+  const std::size_t vectorKeys = keyCount - keyCount % 8;
+  alignas(32) uint32_t lanes[8];
+  alignas(32) uint32_t results[seedsPerPass][8];
+
+  for (std::size_t firstKey = 0; firstKey < vectorKeys; firstKey += 8) {
+      const uint8_t* base = keys + firstKey * keySize;
+
+      __m256i tail = _mm256_setzero_si256(); // keys of whole blocks have no tail
+      if ((keySize & 3) != 0) {
+          for (std::size_t lane = 0; lane < 8; ++lane) {
+              lanes[lane] = mixed_tail(base + lane * keySize, keySize);
+          }
+          tail = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes));
+      }
+
+      for (std::size_t seedStart = 0; seedStart < seedCount; seedStart += seedsPerPass) {
+          const std::size_t passSeeds = seedCount - seedStart < seedsPerPass ? seedCount - seedStart : seedsPerPass;
+          __m256i h[seedsPerPass];
+          for (std::size_t s = 0; s < passSeeds; ++s) {
+              h[s] = _mm256_set1_epi32(static_cast<int>(seeds[seedStart + s]));
+          }
+
+          for (std::size_t block = 0; block < numBlocks; ++block) {
+              __m256i k = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base + block * 4), offsets, 1);
+              k = _mm256_mullo_epi32(k, c1);
+              k = _mm256_or_si256(_mm256_slli_epi32(k, 15), _mm256_srli_epi32(k, 17));
+              k = _mm256_mullo_epi32(k, c2);
+              for (std::size_t s = 0; s < passSeeds; ++s) {
+                  __m256i hash = _mm256_xor_si256(h[s], k);
+                  hash = _mm256_or_si256(_mm256_slli_epi32(hash, 13), _mm256_srli_epi32(hash, 19));
+                  h[s] = _mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(hash, 2), hash), c3);
+              }
+          }
+
+          for (std::size_t s = 0; s < passSeeds; ++s) {
+              __m256i hash = _mm256_xor_si256(_mm256_xor_si256(h[s], tail), length);
+              hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+              hash = _mm256_mullo_epi32(hash, f1);
+              hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 13));
+              hash = _mm256_mullo_epi32(hash, f2);
+              hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+              _mm256_store_si256(reinterpret_cast<__m256i*>(results[s]), hash);
+          }
+          // Transpose to key-major order
+          for (std::size_t lane = 0; lane < 8; ++lane) {
+              uint32_t* keyOut = out + (firstKey + lane) * seedCount + seedStart;
+              for (std::size_t s = 0; s < passSeeds; ++s) {
+                  keyOut[s] = results[s][lane];
+              }
+          }
+      }
+  }
+  return vectorKeys;
+}
+
+// GCC's AVX-512 headers trip warnings of their own: shifts start from an "undefined" register
+// (-Wmaybe-uninitialized at -O2) and the gather macro narrows its all-ones mask (-Wsign-conversion at -O0)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#endif
+
+// Same as hash_avx2 with sixteen keys per step
+__attribute__((target("avx512f")))
+inline std::size_t hash_avx512(const uint8_t* keys, std::size_t keySize, std::size_t keyCount,
+    const uint32_t* seeds, std::size_t seedCount, uint32_t* out) {
+  const std::size_t numBlocks = keySize / 4;
+  const int stride = static_cast<int>(keySize);
+  const __m512i offsets = _mm512_mullo_epi32(
+      _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(stride));
+  const __m512i c1 = _mm512_set1_epi32(static_cast<int>(0xcc9e2d51u));
+  const __m512i c2 = _mm512_set1_epi32(static_cast<int>(0x1b873593u));
+  const __m512i c3 = _mm512_set1_epi32(static_cast<int>(0xe6546b64u));
+  const __m512i f1 = _mm512_set1_epi32(static_cast<int>(0x85ebca6bu));
+  const __m512i f2 = _mm512_set1_epi32(static_cast<int>(0xc2b2ae35u));
+  const __m512i length = _mm512_set1_epi32(static_cast<int>(final_length(keySize)));
+
+  const std::size_t vectorKeys = keyCount - keyCount % 16;
+  alignas(64) uint32_t lanes[16];
+  alignas(64) uint32_t results[seedsPerPass][16];
+
+  for (std::size_t firstKey = 0; firstKey < vectorKeys; firstKey += 16) {
+      const uint8_t* base = keys + firstKey * keySize;
+
+      __m512i tail = _mm512_setzero_si512(); // keys of whole blocks have no tail
+      if ((keySize & 3) != 0) {
+          for (std::size_t lane = 0; lane < 16; ++lane) {
+              lanes[lane] = mixed_tail(base + lane * keySize, keySize);
+          }
+          tail = _mm512_load_si512(lanes);
+      }
+
+      for (std::size_t seedStart = 0; seedStart < seedCount; seedStart += seedsPerPass) {
+          const std::size_t passSeeds = seedCount - seedStart < seedsPerPass ? seedCount - seedStart : seedsPerPass;
+          __m512i h[seedsPerPass];
+          for (std::size_t s = 0; s < passSeeds; ++s) {
+              h[s] = _mm512_set1_epi32(static_cast<int>(seeds[seedStart + s]));
+          }
+
+          for (std::size_t block = 0; block < numBlocks; ++block) {
+              __m512i k = _mm512_i32gather_epi32(offsets, base + block * 4, 1);
+              k = _mm512_mullo_epi32(k, c1);
+              k = _mm512_or_si512(_mm512_slli_epi32(k, 15), _mm512_srli_epi32(k, 17));
+              k = _mm512_mullo_epi32(k, c2);
+              for (std::size_t s = 0; s < passSeeds; ++s) {
+                  __m512i hash = _mm512_xor_si512(h[s], k);
+                  hash = _mm512_or_si512(_mm512_slli_epi32(hash, 13), _mm512_srli_epi32(hash, 19));
+                  h[s] = _mm512_add_epi32(_mm512_add_epi32(_mm512_slli_epi32(hash, 2), hash), c3);
+              }
+          }
+
+          for (std::size_t s = 0; s < passSeeds; ++s) {
+              __m512i hash = _mm512_xor_si512(_mm512_xor_si512(h[s], tail), length);
+              hash = _mm512_xor_si512(hash, _mm512_srli_epi32(hash, 16));
+              hash = _mm512_mullo_epi32(hash, f1);
+              hash = _mm512_xor_si512(hash, _mm512_srli_epi32(hash, 13));
+              hash = _mm512_mullo_epi32(hash, f2);
+              hash = _mm512_xor_si512(hash, _mm512_srli_epi32(hash, 16));
+              _mm512_store_si512(results[s], hash);
+          }
+          for (std::size_t lane = 0; lane < 16; ++lane) {
+              uint32_t* keyOut = out + (firstKey + lane) * seedCount + seedStart;
+              for (std::size_t s = 0; s < passSeeds; ++s) {
+                  keyOut[s] = results[s][lane];
+              }
+          }
+      }
+  }
+  return vectorKeys;
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif  // MURMUR3_BATCH_X86
+
+inline Murmur3Kernel detect_kernel() {
+#if MURMUR3_BATCH_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return Murmur3Kernel::avx512;
+  if (__builtin_cpu_supports("avx2")) return Murmur3Kernel::avx2;
+#endif
+  return Murmur3Kernel::scalar;
+}
+
+}  // namespace murmur3_detail
+
+// The fastest kernel this CPU supports (detected once)
+inline Murmur3Kernel murmur3_best_kernel() {
+  static const Murmur3Kernel kernel = murmur3_detail::detect_kernel();
+  return kernel;
+}
+
+// Hashes `keyCount` keys of `keySize` bytes each, stored back to back at `keys`, with each of the
+// `seedCount` seeds; see the top of the file for the output layout.
+// `kernel` defaults to the best one available; asking for an unsupported kernel falls back to it.
+inline void murmur3_32_batch(const uint8_t* keys, std::size_t keySize, std::size_t keyCount,
+    const uint32_t* seeds, std::size_t seedCount, uint32_t* out,
+    Murmur3Kernel kernel = murmur3_best_kernel()) {
+  if (static_cast<int>(kernel) > static_cast<int>(murmur3_best_kernel())) {
+      kernel = murmur3_best_kernel();
+  }
+
+  std::size_t keysDone = 0;
+#if MURMUR3_BATCH_X86
+  // Gather offsets are 32-bit, which bounds the key width the vector kernels accept
+  if (keySize > 0 && keySize <= (1u << 24)) {
+      if (kernel == Murmur3Kernel::avx512) {
+          keysDone = murmur3_detail::hash_avx512(keys, keySize, keyCount, seeds, seedCount, out);
+      }
+      else if (kernel == Murmur3Kernel::avx2) {
+          keysDone = murmur3_detail::hash_avx2(keys, keySize, keyCount, seeds, seedCount, out);
+      }
+  }
+#endif
+  murmur3_detail::hash_scalar(keys, keySize, keysDone, keyCount, seeds, seedCount, out);
+}
+
+#endif  // MURMURHASH_BATCH_HPP
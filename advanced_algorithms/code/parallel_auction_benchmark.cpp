@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "assignment_solver.hpp"
+#include "auction_assignment.hpp"
+#include "matrix.hpp"
+
+// Thread scaling of the parallel auction on one dense n x n random cost matrix at 1, 2, 4, ...
+// threads. Every run must produce exactly the same assignment (deterministic tie-breaking);
+// up to n = 5000 the cost is also checked against the Jonker-Volgenant solver.
+// usage: a4_parallel_auction_benchmark [n] [max cost] [max threads]
+
+namespace {
+
+template <typename Solve>
+double seconds_for(Solve solve) {
+    auto start = std::chrono::steady_clock::now();
+    solve();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, const char* argv[]) {
+    std::size_t size = argc > 1 ? std::stoul(argv[1]) : 4000;
+    int maxCost = argc > 2 ? std::stoi(argv[2]) : 100000;
+    unsigned int maxThreads = argc > 3 ? static_cast<unsigned int>(std::stoul(argv[3]))
+                                       : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t referenceLimit = 5000;
+
+    std::mt19937 generator(2024);
+    std::uniform_int_distribution<int> costDistribution(0, maxCost);
+    Matrix<int> costMatrix(size, size, uninitialized);
+    for (std::size_t row = 0; row < size; row++) {
+        for (std::size_t col = 0; col < size; col++) {
+            costMatrix(row, col) = costDistribution(generator);
+        }
+    }
+
+    std::cout << "n = " << size << std::fixed << std::setprecision(4);
+    if (size <= referenceLimit) {
+        AssignmentResult<int> reference;
+        double referenceSeconds = seconds_for([&] { reference = solve_assignment(costMatrix); });
+        std::cout << ", Jonker-Volgenant: " << referenceSeconds << " s, cost " << reference.totalCost;
+
+        AssignmentResult<int> check = solve_parallel_auction(costMatrix, 1);
+        if (check.totalCost != reference.totalCost) {
+            std::cout << std::endl;
+            std::cerr << "Auction cost " << check.totalCost << " is not optimal" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << '\n' << std::setw(8) << "threads" << std::setw(14) << "auction [s]" << std::setw(10) << "speedup"
+        << std::setw(16) << "cost" << '\n';
+
+    // 1, 2, 4, ... and finally maxThreads itself
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    AssignmentResult<int> firstResult;
+    double singleThreadSeconds = 0.0;
+    for (unsigned int threadCount : threadCounts) {
+        AssignmentResult<int> result;
+        double seconds = seconds_for([&] { result = solve_parallel_auction(costMatrix, threadCount); });
+
+        if (threadCount == threadCounts.front()) {
+            firstResult = result;
+            singleThreadSeconds = seconds;
+        }
+        else if (result.rowToColumn != firstResult.rowToColumn) {
+            std::cerr << "Assignment with " << threadCount << " threads differs from the first run" << std::endl;
+            return 1;
+        }
+
+        std::cout << std::setw(8) << threadCount << std::setprecision(4) << std::setw(14) << seconds
+            << std::setprecision(2) << std::setw(9) << singleThreadSeconds / seconds << 'x'
+            << std::setw(16) << result.totalCost << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,311 @@
+#ifndef RUNTIME_BLOOM_FILTER_HPP
+#define RUNTIME_BLOOM_FILTER_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+#include "bloom_common.hpp"
+#include "bloom_file.hpp"
+
+// RuntimeBloomFilter class template
+// Same queries as BloomFilter, but the number of bits and hash functions are chosen at run time
+// and the bits live on the heap, aligned to a cache line. One instantiation serves every size.
+// Seeded policies give 32-bit hashes, which reach only 2^32 bit positions (512 MiB). Above that
+// the default BloomHash is replaced at run time by BloomDoubleHash, whose 64-bit probes reach
+// every bit; any other seeded policy throws Invalid for such a size.
+// Key: type of elements stored
+// HashFunction: hashing strategy (defaults to DefaultBloomHash, see bloom_common.hpp)
+template <typename Key, typename HashFunction = DefaultBloomHash<Key>>
+class RuntimeBloomFilter {
+public:
+    // Thrown when the requested shape is invalid
+    class Invalid {};
+
+    static constexpr std::size_t batchGroupSize = 16; // keys hashed and prefetched together
+
+    // Constructor: sizes the filter for `expectedElementCount` keys at `targetFalsePositiveRate`
+    // using the optimal bit count and number of hash functions
+    RuntimeBloomFilter(uint64_t expectedElementCount, double targetFalsePositiveRate) {
+        if (expectedElementCount == 0 || !(targetFalsePositiveRate > 0.0 && targetFalsePositiveRate < 1.0)) {
+            throw Invalid{};
+        }
+        numBits_ = bloom_optimal_num_bits(expectedElementCount, targetFalsePositiveRate);
+        numberOfHashFunctions_ = bloom_optimal_num_hash_functions(numBits_, expectedElementCount);
+        wideProbes_ = needs_wide_probes(numBits_);
+        bitStorage_ = AlignedWordArray((numBits_ + 63) / 64);
+    }
+
+    // Creates an empty filter with an explicit number of bits and hash functions
+    static RuntimeBloomFilter with_shape(uint64_t numBits, unsigned int numberOfHashFunctions) {
+        if (numBits == 0 || numberOfHashFunctions == 0) {
+            throw Invalid{};
+        }
+        return RuntimeBloomFilter(numBits, numberOfHashFunctions, AlignedWordArray((numBits + 63) / 64));
+    }
+
+    // Inserts a key into the Bloom filter
+    // Returns true if at least one new bit was set (i.e., changed from 0 to 1)
+    bool insert(const Key& element) {
+        if constexpr (canWidenProbes) {
+            if (wideProbes_) {
+                return insert_probes(BloomProbes<Key, WideHashFunction>(wideHasher_, element));
+            }
+        }
+        return insert_probes(BloomProbes<Key, HashFunction>(hasher_, element));
+    }
+
+    // Checks if a key is *possibly* in the filter
+    // Returns false if definitely not present, true if possibly present (could be a false positive)
+    bool contains(const Key& element) const {
+        if constexpr (canWidenProbes) {
+            if (wideProbes_) {
+                return contains_probes(BloomProbes<Key, WideHashFunction>(wideHasher_, element));
+            }
+        }
+        return contains_probes(BloomProbes<Key, HashFunction>(hasher_, element));
+    }
+
+    // Inserts every key of the span, prefetching the probe words of a group of keys first
+    // Returns the number of keys that set at least one new bit
+    std::size_t insert_batch(std::span<const Key> elements) {
+        std::vector<uint64_t> bitPositions(batchGroupSize * numberOfHashFunctions_);
+        std::size_t newlyInsertedCount = 0;
+
+        for (std::size_t groupStart = 0; groupStart < elements.size(); groupStart += batchGroupSize) {
+            std::size_t groupSize = std::min(batchGroupSize, elements.size() - groupStart);
+            hash_group(elements.subspan(groupStart, groupSize), bitPositions);
+
+            for (std::size_t position = 0; position < groupSize * numberOfHashFunctions_; position++) {
+                bloom_prefetch_write(bitStorage_.data() + bitPositions[position] / 64);
+            }
+
+            for (std::size_t keyIndex = 0; keyIndex < groupSize; keyIndex++) {
+                bool atLeastOneBitNewlySet = false;
+                for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
+                    uint64_t bitPosition = bitPositions[keyIndex * numberOfHashFunctions_ + hashIndex];
+                    if (!test_bit(bitPosition)) {
+                        atLeastOneBitNewlySet = true;
+                    }
+                    set_bit(bitPosition);
+                }
+                if (atLeastOneBitNewlySet) {
+                    newlyInsertedCount++;
+                }
+            }
+        }
+
+        return newlyInsertedCount;
+    }
+
+    // Looks up every key of the span; results[i] receives contains(elements[i])
+    void contains_batch(std::span<const Key> elements, std::span<bool> results) const {
+        assert(results.size() >= elements.size());
+        std::vector<uint64_t> bitPositions(batchGroupSize * numberOfHashFunctions_);
+
+        for (std::size_t groupStart = 0; groupStart < elements.size(); groupStart += batchGroupSize) {
+            std::size_t groupSize = std::min(batchGroupSize, elements.size() - groupStart);
+            hash_group(elements.subspan(groupStart, groupSize), bitPositions);
+
+            for (std::size_t position = 0; position < groupSize * numberOfHashFunctions_; position++) {
+                bloom_prefetch_read(bitStorage_.data() + bitPositions[position] / 64);
+            }
+
+            for (std::size_t keyIndex = 0; keyIndex < groupSize; keyIndex++) {
+                bool possiblyPresent = true;
+                for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_ && possiblyPresent; hashIndex++) {
+                    possiblyPresent = test_bit(bitPositions[keyIndex * numberOfHashFunctions_ + hashIndex]);
+                }
+                results[groupStart + keyIndex] = possiblyPresent;
+            }
+        }
+    }
+
+    // Calculate false positive rate over a set of keys known not to be in the filter
+    // (the positives are accepted for interface parity with BloomFilter)
+    template <typename Iterator>
+    double false_positive_rate(
+        Iterator /*knownPositivesBegin*/, Iterator /*knownPositivesEnd*/,
+        Iterator knownNegativesBegin, Iterator knownNegativesEnd) const {
+
+        uint64_t falsePositiveCount = 0;
+        uint64_t totalNegativeSamples = 0;
+
+        for (Iterator it = knownNegativesBegin; it != knownNegativesEnd; ++it) {
+            totalNegativeSamples++;
+            if (contains(*it)) {
+                falsePositiveCount++;
+            }
+        }
+
+        if (totalNegativeSamples == 0) return 0.0; // Avoid division by zero
+
+        return static_cast<double>(falsePositiveCount) / static_cast<double>(totalNegativeSamples);
+    }
+
+    // Compares heap memory used by the filter vs. storing the keys themselves
+    double space_ratio(uint64_t expectedElementCount) const {
+        std::size_t actualBitMemory = memory_bytes();
+        std::size_t optimalBitMemory = expectedElementCount * sizeof(Key);
+        return static_cast<double>(actualBitMemory) / static_cast<double>(optimalBitMemory);
+    }
+
+    // Estimates how many elements have been inserted, based on number of set bits
+    uint64_t approx_size() const {
+        return bloom_estimate_cardinality(count_set_bits(), numBits_, numberOfHashFunctions_);
+    }
+
+    // Number of bits set to 1, counted a word at a time
+    uint64_t count_set_bits() const {
+        return bloom_count_bits(bitStorage_.data(), bitStorage_.size());
+    }
+
+    // Adds every key of `other` to this filter (bitwise OR of the bit arrays)
+    // Afterwards contains() answers as if all keys of both filters had been inserted here.
+    // Throws Invalid unless both filters have the same number of bits and hash functions
+    void merge(const RuntimeBloomFilter& other) {
+        require_same_shape(other);
+        bloom_merge_words(bitStorage_.data(), other.bitStorage_.data(), bitStorage_.size());
+    }
+
+    // Keeps only the bits set in both filters (bitwise AND)
+    // The result contains every key of the intersection, plus more false positives than a filter
+    // built from the intersection alone. Throws Invalid on a shape mismatch
+    void intersect(const RuntimeBloomFilter& other) {
+        require_same_shape(other);
+        bloom_intersect_words(bitStorage_.data(), other.bitStorage_.data(), bitStorage_.size());
+    }
+
+    // Estimated number of distinct keys in the union of both filters, without modifying either
+    uint64_t approx_union_size(const RuntimeBloomFilter& other) const {
+        require_same_shape(other);
+        return bloom_estimate_cardinality(
+            bloom_count_union_bits(bitStorage_.data(), other.bitStorage_.data(), bitStorage_.size()),
+            numBits_, numberOfHashFunctions_);
+    }
+
+    // Estimated number of keys inserted into both filters
+    uint64_t approx_intersection_size(const RuntimeBloomFilter& other) const {
+        return bloom_estimate_intersection(approx_size(), other.approx_size(), approx_union_size(other));
+    }
+
+    // Getter for the number of bits
+    uint64_t num_bits() const { return numBits_; }
+
+    // Getter for the number of hash functions
+    unsigned int num_hash_functions() const { return numberOfHashFunctions_; }
+
+    // Heap bytes held by the bit array
+    std::size_t memory_bytes() const { return bitStorage_.size() * sizeof(uint64_t); }
+
+    // Writes the filter to `path` in the versioned format of bloom_file.hpp,
+    // readable by MappedBloomFilter::open_mapped. A filter above 2^32 bits records the policy it
+    // actually hashes with (BloomDoubleHash). Throws std::runtime_error on I/O failure
+    void save(const std::string& path) const requires PersistableHashPolicy<HashFunction> {
+        BloomFileHeader header = make_bloom_file_header<Key, HashFunction>(BloomLayout::plain, numBits_,
+            numberOfHashFunctions_, bitStorage_.size());
+        if constexpr (canWidenProbes) {
+            if (wideProbes_) {
+                header = make_bloom_file_header<Key, WideHashFunction>(BloomLayout::plain, numBits_,
+                    numberOfHashFunctions_, bitStorage_.size());
+            }
+        }
+        write_bloom_file(path, header, bitStorage_.data(), bitStorage_.size() * sizeof(uint64_t));
+    }
+
+private:
+    // Policy used instead of BloomHash once the filter has more bits than a 32-bit hash can reach
+    using WideHashFunction = BloomDoubleHash<Key>;
+    static constexpr bool canWidenProbes = std::same_as<HashFunction, BloomHash<Key>>;
+    static constexpr uint64_t seededHashPositions = uint64_t{1} << 32;
+    static constexpr WideHashFunction wideHasher_{};
+
+    RuntimeBloomFilter(uint64_t numBits, unsigned int numberOfHashFunctions, AlignedWordArray bitStorage)
+        : numBits_(numBits), numberOfHashFunctions_(numberOfHashFunctions), wideProbes_(needs_wide_probes(numBits)),
+        bitStorage_(std::move(bitStorage)) {
+    }
+
+    // True if `numBits` needs 64-bit probes; throws Invalid if the policy cannot provide them
+    static bool needs_wide_probes(uint64_t numBits) {
+        if constexpr (DoubleHashPolicy<HashFunction, Key>) {
+            return false;
+        }
+        else {
+            if (numBits <= seededHashPositions) {
+                return false;
+            }
+            if constexpr (!canWidenProbes) {
+                throw Invalid{};
+            }
+            return true;
+        }
+    }
+
+    template <typename Probes>
+    bool insert_probes(const Probes& probes) {
+        bool atLeastOneBitNewlySet = false;
+
+        for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
+            uint64_t bitPosition = reduce_range(probes(hashIndex), numBits_);
+            if (!test_bit(bitPosition)) {
+                atLeastOneBitNewlySet = true; // A new bit is set, which was previously 0
+            }
+            set_bit(bitPosition);
+        }
+
+        return atLeastOneBitNewlySet;
+    }
+
+    template <typename Probes>
+    bool contains_probes(const Probes& probes) const {
+        for (unsigned int hashIndex = 0; hashIndex < numberOfHashFunctions_; hashIndex++) {
+            if (!test_bit(reduce_range(probes(hashIndex), numBits_))) {
+                return false; // If any bit is 0, the key was not inserted
+            }
+        }
+        return true; // possibly in the set (could be a false positive)
+    }
+
+    void require_same_shape(const RuntimeBloomFilter& other) const {
+        if (numBits_ != other.numBits_ || numberOfHashFunctions_ != other.numberOfHashFunctions_) {
+            throw Invalid{};
+        }
+    }
+
+    bool test_bit(uint64_t bitPosition) const {
+        return (bitStorage_[bitPosition / 64] >> (bitPosition % 64)) & 1;
+    }
+
+    void set_bit(uint64_t bitPosition) {
+        bitStorage_[bitPosition / 64] |= uint64_t{1} << (bitPosition % 64);
+    }
+
+    // Computes all probe positions of a group of keys, key-major
+    void hash_group(std::span<const Key> group, std::vector<uint64_t>& bitPositions) const {
+        auto store = [&](std::size_t keyIndex, unsigned int hashIndex, uint64_t probeHash) {
+            bitPositions[keyIndex * numberOfHashFunctions_ + hashIndex] = reduce_range(probeHash, numBits_);
+        };
+        if constexpr (canWidenProbes) {
+            if (wideProbes_) {
+                bloom_probe_group(wideHasher_, group, numberOfHashFunctions_, store);
+                return;
+            }
+        }
+        bloom_probe_group(hasher_, group, numberOfHashFunctions_, store);
+    }
+
+    uint64_t numBits_ = 0;                  // Size of the bit array
+    unsigned int numberOfHashFunctions_ = 0; // Number of hash functions used
+    bool wideProbes_ = false;               // hashing with WideHashFunction instead of hasher_
+    AlignedWordArray bitStorage_;           // Heap bit array, 64 bits per word, cache-line aligned
+    HashFunction hasher_;                   // hash function functor
+};
+
+#endif  // RUNTIME_BLOOM_FILTER_HPP
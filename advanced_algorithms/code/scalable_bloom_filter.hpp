@@ -0,0 +1,155 @@
+#ifndef SCALABLE_BLOOM_FILTER_HPP
+#define SCALABLE_BLOOM_FILTER_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "bloom_common.hpp"
+#include "runtime_bloom_filter.hpp"
+
+// ScalableBloomFilter class template
+// A Bloom filter for streams of unknown size (Almeida et al., "Scalable Bloom Filters", 2007).
+// Keys go into a chain of RuntimeBloomFilter layers. When the newest layer has taken its capacity,
+// a new layer is added that is `growthFactor` times larger and whose false-positive rate is
+// `tighteningRatio` times smaller. The per-layer rates form a geometric series, so the rate of
+// the whole chain stays below the target however many layers are added.
+// Key: type of elements stored
+// HashFunction: hashing strategy (defaults to DefaultBloomHash, see bloom_common.hpp)
+template <typename Key, typename HashFunction = DefaultBloomHash<Key>>
+class ScalableBloomFilter {
+public:
+    using Layer = RuntimeBloomFilter<Key, HashFunction>;
+
+    // Thrown when the growth parameters are invalid
+    class Invalid {};
+
+    // Constructor: the first layer holds `initialCapacity` keys; the chain as a whole keeps its
+    // false-positive rate below `targetFalsePositiveRate`
+    ScalableBloomFilter(uint64_t initialCapacity, double targetFalsePositiveRate,
+        double growthFactor = 2.0, double tighteningRatio = 0.85)
+        : initialCapacity_(initialCapacity),
+        targetFalsePositiveRate_(targetFalsePositiveRate),
+        growthFactor_(growthFactor),
+        tighteningRatio_(tighteningRatio) {
+        if (initialCapacity == 0 || !(targetFalsePositiveRate > 0.0 && targetFalsePositiveRate < 1.0) ||
+            growthFactor < 1.0 || !(tighteningRatio > 0.0 && tighteningRatio < 1.0)) {
+            throw Invalid{};
+        }
+        add_layer();
+    }
+
+    // Inserts a key into the newest layer only, growing the chain first if that layer is full
+    // A key that any layer already (possibly) holds is skipped, so duplicates neither use up
+    // capacity nor get counted twice by approx_size()
+    // Returns true if the key was added, false if the filter already reported it as present
+    bool insert(const Key& element) {
+        if (contains(element)) {
+            return false;
+        }
+        if (insertedInNewestLayer_ >= layerCapacities_.back()) {
+            add_layer();
+        }
+        layers_.back().insert(element);
+        insertedInNewestLayer_++;
+        return true;
+    }
+
+    // Checks if a key is *possibly* in the filter
+    // The largest (newest) layer holds most keys, so it is tried first
+    bool contains(const Key& element) const {
+        for (auto layer = layers_.rbegin(); layer != layers_.rend(); ++layer) {
+            if (layer->contains(element)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Calculate false positive rate over a set of keys known not to be in the filter
+    // (the positives are accepted for interface parity with BloomFilter)
+    template <typename Iterator>
+    double false_positive_rate(
+        Iterator /*knownPositivesBegin*/, Iterator /*knownPositivesEnd*/,
+        Iterator knownNegativesBegin, Iterator knownNegativesEnd) const {
+
+        uint64_t falsePositiveCount = 0;
+        uint64_t totalNegativeSamples = 0;
+
+        for (Iterator it = knownNegativesBegin; it != knownNegativesEnd; ++it) {
+            totalNegativeSamples++;
+            if (contains(*it)) {
+                falsePositiveCount++;
+            }
+        }
+
+        if (totalNegativeSamples == 0) return 0.0; // Avoid division by zero
+
+        return static_cast<double>(falsePositiveCount) / static_cast<double>(totalNegativeSamples);
+    }
+
+    // Compares memory used by all layers vs. storing the keys themselves
+    double space_ratio(uint64_t expectedElementCount) const {
+        std::size_t actualBitMemory = 0;
+        for (const Layer& layer : layers_) {
+            actualBitMemory += layer.memory_bytes();
+        }
+        std::size_t optimalBitMemory = expectedElementCount * sizeof(Key);
+        return static_cast<double>(actualBitMemory) / static_cast<double>(optimalBitMemory);
+    }
+
+    // Estimates how many elements have been inserted: the sum of the layer estimates
+    // Returns uint64_t(-1) if any layer is saturated
+    uint64_t approx_size() const {
+        uint64_t estimatedInsertedElements = 0;
+        for (const Layer& layer : layers_) {
+            uint64_t layerSize = layer.approx_size();
+            if (layerSize == static_cast<uint64_t>(-1)) {
+                return layerSize;
+            }
+            estimatedInsertedElements += layerSize;
+        }
+        return estimatedInsertedElements;
+    }
+
+    // Upper bound on the false-positive rate of the current chain: the sum of the layer targets
+    double false_positive_bound() const {
+        double bound = 0.0;
+        for (std::size_t layerIndex = 0; layerIndex < layers_.size(); layerIndex++) {
+            bound += layer_false_positive_rate(layerIndex);
+        }
+        return bound;
+    }
+
+    // Getter for the number of layers in the chain
+    std::size_t num_layers() const { return layers_.size(); }
+
+    // Read access to one layer (0 = oldest and smallest)
+    const Layer& layer(std::size_t layerIndex) const { return layers_[layerIndex]; }
+
+private:
+    // Target rate of layer i: P * (1 - r) * r^i, so that the sum over all layers stays below P
+    double layer_false_positive_rate(std::size_t layerIndex) const {
+        return targetFalsePositiveRate_ * (1.0 - tighteningRatio_) *
+            std::pow(tighteningRatio_, static_cast<double>(layerIndex));
+    }
+
+    void add_layer() {
+        std::size_t layerIndex = layers_.size();
+        uint64_t capacity = static_cast<uint64_t>(
+            static_cast<double>(initialCapacity_) * std::pow(growthFactor_, static_cast<double>(layerIndex)));
+        layers_.emplace_back(capacity, layer_false_positive_rate(layerIndex));
+        layerCapacities_.push_back(capacity);
+        insertedInNewestLayer_ = 0;
+    }
+
+    std::vector<Layer> layers_;             // Oldest first; only the last one receives inserts
+    std::vector<uint64_t> layerCapacities_; // Keys each layer was sized for
+    uint64_t insertedInNewestLayer_ = 0;    // Keys added to the newest layer
+    uint64_t initialCapacity_;
+    double targetFalsePositiveRate_;
+    double growthFactor_;
+    double tighteningRatio_;
+};
+
+#endif  // SCALABLE_BLOOM_FILTER_HPP
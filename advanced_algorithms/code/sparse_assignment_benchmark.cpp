@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "assignment_solver.hpp"
+#include "auction_assignment.hpp"
+
+// Dense/sparse crossover: for one n x n problem size and a sweep of densities (share of allowed
+// pairs), times the sparse epsilon-scaling auction on the CSR structure against the dense
+// Jonker-Volgenant solver on the full matrix, where forbidden pairs get a prohibitive cost.
+// Every row gets one allowed pair from a random permutation, so all instances are feasible and
+// both solvers must agree on the optimal cost.
+// usage: a4_sparse_assignment_benchmark [n] [max cost]
+
+namespace {
+
+struct Instance {
+    std::vector<AssignmentEdge<int>> edges;
+    std::vector<int> denseCosts;
+};
+
+Instance random_instance(std::size_t size, double density, int maxCost, int forbiddenCost, std::mt19937& generator) {
+    std::uniform_int_distribution<int> costDistribution(0, maxCost);
+    std::bernoulli_distribution isAllowed(density);
+
+    std::vector<std::size_t> permutation(size);
+    for (std::size_t row = 0; row < size; row++) {
+        permutation[row] = row;
+    }
+    std::shuffle(permutation.begin(), permutation.end(), generator);
+
+    Instance instance;
+    instance.denseCosts.assign(size * size, forbiddenCost);
+    for (std::size_t row = 0; row < size; row++) {
+        for (std::size_t col = 0; col < size; col++) {
+            if (permutation[row] == col || isAllowed(generator)) {
+                int cost = costDistribution(generator);
+                instance.edges.push_back({row, col, cost});
+                instance.denseCosts[row * size + col] = cost;
+            }
+        }
+    }
+    return instance;
+}
+
+template <typename Solve>
+double seconds_for(Solve solve) {
+    auto start = std::chrono::steady_clock::now();
+    solve();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, const char* argv[]) {
+    std::size_t size = argc > 1 ? std::stoul(argv[1]) : 2000;
+    int maxCost = argc > 2 ? std::stoi(argv[2]) : 100000;
+
+    // Larger than any assignment that uses allowed pairs only
+    int forbiddenCost = static_cast<int>(std::min<int64_t>(std::numeric_limits<int>::max(),
+        static_cast<int64_t>(maxCost) * static_cast<int64_t>(size) + 1));
+
+    const double densities[] = {1.0, 0.5, 0.2, 0.1, 0.05, 0.02, 0.01, 0.005, 0.002};
+    std::mt19937 generator(2024);
+
+    std::cout << "n = " << size << '\n' << std::setw(9) << "density" << std::setw(10) << "edges"
+        << std::setw(14) << "cost" << std::setw(14) << "sparse [s]" << std::setw(14) << "dense [s]"
+        << std::setw(10) << "speedup" << '\n';
+
+    for (double density : densities) {
+        Instance instance = random_instance(size, density, maxCost, forbiddenCost, generator);
+        SparseCostMatrix<int> sparseCosts(size, size, instance.edges);
+
+        AssignmentResult<int> sparse;
+        AssignmentResult<int> dense;
+        double sparseSeconds = seconds_for([&] { sparse = solve_sparse_assignment(sparseCosts); });
+        double denseSeconds = seconds_for([&] {
+            dense = solve_assignment(std::span<const int>(instance.denseCosts), size, size);
+        });
+
+        if (!sparse.feasible || sparse.totalCost != dense.totalCost) {
+            std::cerr << "Sparse and dense solutions disagree at density " << density << std::endl;
+            return 1;
+        }
+
+        std::cout << std::setw(8) << std::fixed << std::setprecision(1) << density * 100 << '%'
+            << std::setw(10) << sparseCosts.edge_count() << std::setw(14) << sparse.totalCost
+            << std::setprecision(4) << std::setw(14) << sparseSeconds << std::setw(14) << denseSeconds
+            << std::setprecision(1) << std::setw(9) << denseSeconds / sparseSeconds << 'x' << std::endl;
+    }
+
+    return 0;
+}
@@ -8,6 +8,8 @@
 #include <utility>
 #include <vector>
 
+#include "../../advanced_algorithms/code/runtime_bloom_filter.hpp"
+
 using std::cout;
 using std::cerr;
 using std::endl;
@@ -160,18 +162,17 @@ string unhash_kmer(uint64_t id, int k)
 }
 
 
-// Count k-mers in the sequence using a skip pattern
+// Call visit(id) for every k-mer of the sequence (as its hash_kmer id) using a skip pattern
 
-unordered_map<uint64_t, int>
-count_skip_kmers(const string& seq, int k, int skip)
+template <typename Visit>
+void for_each_skip_kmer(const string& seq, int k, int skip, Visit visit)
 {
-    unordered_map<uint64_t, int> counts;
     int step = skip + 1; // How many positions to jump between bases
     int window_len = step * (k - 1) + 1;  // Total span of one k-mer
 
-    // If the sequence is too short, return an empty map
+    // If the sequence is too short, there is nothing to visit
 
-    if (seq.size() < static_cast<size_t>(window_len)) return counts;
+    if (seq.size() < static_cast<size_t>(window_len)) return;
 
     // Loop over all possible start positions for k-mers
 
@@ -189,10 +190,56 @@ count_skip_kmers(const string& seq, int k, int skip)
             kmer += seq[start + j * step];
 
 
-        // Hash the k-mer and count it
-
-        counts[hash_kmer(kmer)]++;
+        visit(hash_kmer(kmer));
     }
+}
+
+// Count k-mers in the sequence using a skip pattern
+
+unordered_map<uint64_t, int>
+count_skip_kmers(const string& seq, int k, int skip)
+{
+    unordered_map<uint64_t, int> counts;
+
+    // Hash the k-mer and count it
+
+    for_each_skip_kmer(seq, k, skip, [&](uint64_t id) { counts[id]++; });
+    return counts;
+}
+
+// Count only the k-mers that occur at least twice, without a table entry per singleton.
+// Pass 1 routes every k-mer through a Bloom filter; a k-mer gets a table entry only when the
+// filter has (possibly) seen it before. Bloom false positives let a few singletons in, so
+// pass 2 recounts the table entries exactly and drops every k-mer seen only once.
+// The counts returned are exact.
+
+unordered_map<uint64_t, int>
+count_repeated_skip_kmers(const string& seq, int k, int skip)
+{
+    unordered_map<uint64_t, int> counts;
+    int window_len = (skip + 1) * (k - 1) + 1;
+
+    if (seq.size() < static_cast<size_t>(window_len)) return counts;
+
+    // Sized for one k-mer per start position at a 1% false-positive rate
+
+    RuntimeBloomFilter<PackedKmer> seen(seq.size() - static_cast<size_t>(window_len) + 1, 0.01);
+
+    // Pass 1: insert() reports whether any bit was new; if none was, the k-mer is a candidate
+
+    for_each_skip_kmer(seq, k, skip, [&](uint64_t id) {
+        if (!seen.insert(PackedKmer{ id }))
+            counts.emplace(id, 0);
+        });
+
+    // Pass 2: exact counts for the candidates only
+
+    for_each_skip_kmer(seq, k, skip, [&](uint64_t id) {
+        auto it = counts.find(id);
+        if (it != counts.end()) it->second++;
+        });
+
+    std::erase_if(counts, [](const auto& entry) { return entry.second < 2; });
     return counts;
 }
 
@@ -223,13 +270,16 @@ int main(int argc, char* argv[])
 
     // Check input arguments
 
-    if (argc != 4) {
-        cerr << "Usage: ./task3 <fasta_file> <k> <skip>\n";
+    if (argc != 4 && !(argc == 5 && string(argv[4]) == "--bloom")) {
+        cerr << "Usage: ./task3 <fasta_file> <k> <skip> [--bloom]\n"
+             << "  --bloom  report only k-mers seen at least twice, using a Bloom filter\n"
+             << "           so that singletons never take a table entry\n";
         return 1;
     }
     string fasta_path = argv[1]; //Path to input file
     int     k = std::stoi(argv[2]); // Length of k-mers
     int     skip = std::stoi(argv[3]); // Number of characters to skip
+    bool    bloom_prefilter = (argc == 5); // Two-stage counting, see count_repeated_skip_kmers
 
 
     // Read valid sequences from FASTA file
@@ -244,7 +294,8 @@ int main(int argc, char* argv[])
 
         // Count k-mers with skips
 
-        auto counts = count_skip_kmers(seq, k, skip);
+        auto counts = bloom_prefilter ? count_repeated_skip_kmers(seq, k, skip)
+                                      : count_skip_kmers(seq, k, skip);
 
 
         if (counts.empty()) continue; // If no valid k - mers, skip it